@@ -9,15 +9,28 @@
 #include <limits.h>
 #include <unistd.h>
 #include <string.h>
+#include <errno.h>
 
-// #include <windows.h>
+#ifndef _WIN32
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <poll.h>
+#include <signal.h>
+#endif
 
-// Definir el comando para ejecutar el programa de la colonia de hormigas en Windows y Linux
-#ifdef _WIN32
-#define COMANDO "Colonia_Hormigas.exe"
-#else
-#define COMANDO "./Colonia_Hormigas"
+#include "Colonia_Hormigas.h"
+
+// Instancia que se optimiza si no se da otra como argumento, se carga una sola vez para todas las evaluaciones
+#define INSTANCIA "Instancias/Csv/C101.csv"
+
+// Tiempo máximo en segundos que puede tardar una evaluación antes de considerarla colgada
+#ifndef TIEMPO_LIMITE_EVALUACION
+#define TIEMPO_LIMITE_EVALUACION 120.0
 #endif
+// Número de veces que se repite una evaluación que falló (violación de segmento o tiempo agotado) con otra semilla
+#define MAX_REINTENTOS 2
+// Valor de la función objetivo que se asigna a una evaluación que nunca terminó, el evolutivo la descarta
+#define FO_PENALIZACION 1000000000.0
 
 // Estructura de los parámetros
 typedef struct
@@ -31,90 +44,417 @@ typedef struct
     int Tipo_Evaluacion; // Tipo de evaluación
 } Parametros;
 
-// Funcion para evaluar la función objetivo
-void Evaluar_FO(Parametros *Vector, int Tam_Poblacion, int Tipo_Evaluacion)
+// Una evaluación pendiente o en curso dentro del grupo de trabajadores
+typedef struct
 {
-    float FO_Mejor = 1000000000.0; // Inicializar la función objetivo mejor con un valor muy grande
-    // Bucle para evaluar la función objetivo
-    for (int i = 0; i < Tam_Poblacion; i++)
+    Parametros *Individuo; // Parámetros a evaluar, aquí se guarda la FO
+    int Indice;            // Posición en su población, define el archivo de rutas
+    int Tipo_Evaluacion;   // 1 = Objetivo, 2 = Ruidoso, 3 = Prueba
+    int Intentos;          // Número de veces que se ha lanzado
+    pid_t pid;             // Proceso que la ejecuta
+    int fd;                // Extremo de lectura de su canal de resultados
+    double Inicio;         // Momento en que se lanzó
+    char *Buffer;          // Bytes recibidos por el canal
+    size_t Tam_Buffer;     // Bytes validos en Buffer
+    size_t Capacidad;      // Bytes reservados en Buffer
+} Evaluacion;
+
+// Encabezado del resultado que manda cada trabajador por su canal, seguido de Inicio_Ruta y Nodos
+typedef struct
+{
+    double Mejor_Distancia;
+    int Numero_Rutas;
+    int Total_Nodos;
+} Encabezado_Resultado;
+
+// Parámetros de la colonia para un individuo del evolutivo
+static Configuracion_Colonia Configurar_Colonia(const Parametros *Individuo)
+{
+    Configuracion_Colonia Configuracion;
+    Configuracion.Numero_Iteraciones = 3;
+    Configuracion.Numero_Hormigas = 10;
+    Configuracion.Alpha = Individuo->Alpha;
+    Configuracion.Beta = Individuo->Beta;
+    Configuracion.Gamma = Individuo->Gamma;
+    Configuracion.Rho = Individuo->Rho;
+    Configuracion.Semilla = (unsigned int)rand();
+    Configuracion.Numero_Hilos = 1; // Ya hay un trabajador por núcleo
+    Configuracion.Hormigas_Busqueda_Local = HORMIGAS_BUSQUEDA_LOCAL;
+    Configurar_Estrategia(&Configuracion, ESTRATEGIA_AS);
+    return Configuracion;
+}
+
+// Guarda la FO y la mejor ruta de una evaluación terminada
+static void Registrar_Evaluacion(Evaluacion *Trabajo, const Resultado_Colonia *Resultado, float *FO_Mejor)
+{
+    Trabajo->Individuo->FO = Resultado->Mejor_Distancia;
+    if (Trabajo->Individuo->FO < *FO_Mejor)
     {
-        // Ejecutar el programa de la colonia de hormigas
-        char buffer[128];
-        /* 1.- Numero de iteraciones
-           2.- Numero de hormigas
-           3.- Alpha
-           4.- Beta
-           5.- Gamma
-           6.- Rho
-           7.- Tipo de evaluacion
-           8.- Numero de archivo
-        */
-        snprintf(buffer, sizeof(buffer), "%s %d %d %f %f %f %f %d %d", COMANDO, 3, 10, Vector[i].Alpha, Vector[i].Beta, Vector[i].Gamma, Vector[i].Rho, Tipo_Evaluacion, i); // i es igual al N de iteraciones, servira para detectar a que archivo meterlo
-        // Ejecutar el comando en la terminal o consola de comandos del sistema operativo (Windows o Linux) para ejecutar el programa de la colonia de hormigas con los parámetros correspondientes 
-        // y guardar el valor de la función objetivo en un archivo de texto llamado FO.txt 
-        system(buffer);
-        // Leer el valor de la función objetivo
-
-        FILE *FO;
-        float valor;
-        
-        char mensaje[100];
-
-        FO = fopen("FuncionObjetivo/FO.txt", "r");
-        if (FO == NULL)
+        *FO_Mejor = Trabajo->Individuo->FO;
+    }
+
+    printf("\nValor FO: %f\n", Trabajo->Individuo->FO);
+    printf("Tipo Evaluacion: %d\n", Trabajo->Tipo_Evaluacion);
+    printf("Numero de iteracion: %d\n", Trabajo->Indice);
+
+    // Guardar la mejor ruta en el archivo del vector e iteración correspondiente
+    char *Route_Archive = Ruta_Archivo(Trabajo->Tipo_Evaluacion, Trabajo->Indice);
+    if (Route_Archive != NULL)
+    {
+        Guardar_Rutas_CSV(Resultado, Route_Archive);
+        free(Route_Archive);
+    }
+}
+
+#ifndef _WIN32
+// Tiempo monotónico en segundos
+static double Tiempo_Actual(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+// Escribe todos los bytes en el canal aunque write los entregue en partes
+static bool Escribir_Todo(int fd, const void *Datos, size_t Tam)
+{
+    const char *p = Datos;
+    while (Tam > 0)
+    {
+        ssize_t n = write(fd, p, Tam);
+        if (n < 0)
         {
-            printf("Error al abrir el archivo.\n");
-            //return 1;
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
         }
+        p += n;
+        Tam -= (size_t)n;
+    }
+    return true;
+}
+
+// Código del proceso trabajador: resuelve la colonia y manda el resultado por su canal
+static void Ejecutar_Trabajador(const Instancia *instancia, Configuracion_Colonia Configuracion, int fd)
+{
+    Resultado_Colonia Resultado;
+    if (Resolver_Colonia(instancia, &Configuracion, &Resultado, NULL, NULL) != 0)
+    {
+        _exit(2);
+    }
 
-        if (fscanf(FO, "%f", &valor) == 1)
+    Encabezado_Resultado Encabezado;
+    Encabezado.Mejor_Distancia = Resultado.Mejor_Distancia;
+    Encabezado.Numero_Rutas = Resultado.Numero_Rutas;
+    Encabezado.Total_Nodos = Resultado.Numero_Rutas > 0 ? Resultado.Inicio_Ruta[Resultado.Numero_Rutas] : 0;
+
+    bool Correcto = Escribir_Todo(fd, &Encabezado, sizeof(Encabezado));
+    if (Correcto && Encabezado.Numero_Rutas > 0)
+    {
+        Correcto = Escribir_Todo(fd, Resultado.Inicio_Ruta, (Encabezado.Numero_Rutas + 1) * sizeof(int)) &&
+                   Escribir_Todo(fd, Resultado.Nodos, Encabezado.Total_Nodos * sizeof(int));
+    }
+    close(fd);
+    _exit(Correcto ? 0 : 3);
+}
+
+// Reconstruye el resultado recibido por el canal, devuelve false si llegó incompleto
+static bool Leer_Resultado(const Evaluacion *Trabajo, Resultado_Colonia *Resultado)
+{
+    Encabezado_Resultado Encabezado;
+    if (Trabajo->Tam_Buffer < sizeof(Encabezado))
+    {
+        return false;
+    }
+    memcpy(&Encabezado, Trabajo->Buffer, sizeof(Encabezado));
+
+    size_t Tam_Rutas = Encabezado.Numero_Rutas > 0 ? (Encabezado.Numero_Rutas + 1) * sizeof(int) : 0;
+    size_t Tam_Nodos = Encabezado.Total_Nodos * sizeof(int);
+    if (Encabezado.Numero_Rutas < 0 || Encabezado.Total_Nodos < 0 || Trabajo->Tam_Buffer != sizeof(Encabezado) + Tam_Rutas + Tam_Nodos)
+    {
+        return false;
+    }
+
+    Resultado->Mejor_Distancia = Encabezado.Mejor_Distancia;
+    Resultado->Numero_Rutas = Encabezado.Numero_Rutas;
+    Resultado->Inicio_Ruta = malloc(Tam_Rutas > 0 ? Tam_Rutas : 1);
+    Resultado->Nodos = malloc(Tam_Nodos > 0 ? Tam_Nodos : 1);
+    if (Resultado->Inicio_Ruta == NULL || Resultado->Nodos == NULL)
+    {
+        Liberar_Resultado(Resultado);
+        return false;
+    }
+    memcpy(Resultado->Inicio_Ruta, Trabajo->Buffer + sizeof(Encabezado), Tam_Rutas);
+    memcpy(Resultado->Nodos, Trabajo->Buffer + sizeof(Encabezado) + Tam_Rutas, Tam_Nodos);
+    return true;
+}
+
+// Lanza un trabajador para la evaluación, devuelve false si no se pudo crear el proceso
+static bool Lanzar_Evaluacion(const Instancia *instancia, Evaluacion *Trabajo)
+{
+    int Canal[2];
+    if (pipe(Canal) != 0)
+    {
+        return false;
+    }
+
+    // La semilla se saca antes del fork para que cada trabajador tenga la suya
+    Configuracion_Colonia Configuracion = Configurar_Colonia(Trabajo->Individuo);
+
+    // Vaciar la salida para que el hijo no repita lo que está en el buffer del padre
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid < 0)
+    {
+        close(Canal[0]);
+        close(Canal[1]);
+        return false;
+    }
+    if (pid == 0)
+    {
+        close(Canal[0]);
+        Ejecutar_Trabajador(instancia, Configuracion, Canal[1]);
+    }
+
+    close(Canal[1]);
+    Trabajo->pid = pid;
+    Trabajo->fd = Canal[0];
+    Trabajo->Inicio = Tiempo_Actual();
+    Trabajo->Tam_Buffer = 0;
+    Trabajo->Intentos++;
+    return true;
+}
+
+// Termina una evaluación en curso: recoge el proceso y devuelve true si entregó un resultado valido
+static bool Cerrar_Evaluacion(Evaluacion *Trabajo, bool Matar, Resultado_Colonia *Resultado)
+{
+    int Estado = 0;
+    if (Matar)
+    {
+        kill(Trabajo->pid, SIGKILL);
+    }
+    close(Trabajo->fd);
+    Trabajo->fd = -1;
+    while (waitpid(Trabajo->pid, &Estado, 0) < 0 && errno == EINTR)
+    {
+    }
+
+    if (Matar)
+    {
+        return false;
+    }
+    if (WIFSIGNALED(Estado))
+    {
+        printf("Error: la evaluacion %d (tipo %d) termino con la senal %d.\n", Trabajo->Indice, Trabajo->Tipo_Evaluacion, WTERMSIG(Estado));
+        return false;
+    }
+    if (!WIFEXITED(Estado) || WEXITSTATUS(Estado) != 0)
+    {
+        printf("Error: la evaluacion %d (tipo %d) termino con el codigo %d.\n", Trabajo->Indice, Trabajo->Tipo_Evaluacion, WEXITSTATUS(Estado));
+        return false;
+    }
+    return Leer_Resultado(Trabajo, Resultado);
+}
+
+// Número de trabajadores simultaneos, uno por núcleo
+static int Numero_Trabajadores(void)
+{
+    long Nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+    return Nucleos > 0 ? (int)Nucleos : 1;
+}
+
+// Funcion para evaluar la función objetivo de un conjunto de individuos con un grupo acotado de procesos trabajadores.
+// Cada evaluación manda su resultado por su propio canal, tiene un tiempo limite y se repite con otra semilla si falla
+void Evaluar_FO(const Instancia *instancia, Evaluacion *Trabajos, int Numero_Trabajos)
+{
+    float FO_Mejor = FO_PENALIZACION; // Inicializar la función objetivo mejor con un valor muy grande
+    int Max_Activos = Numero_Trabajadores();
+
+    // Cola circular de evaluaciones pendientes, las que fallan se vuelven a formar
+    int Pendientes[Numero_Trabajos];
+    int Cabeza = 0, Numero_Pendientes = Numero_Trabajos;
+    for (int i = 0; i < Numero_Trabajos; i++)
+    {
+        Pendientes[i] = i;
+        Trabajos[i].Intentos = 0;
+        Trabajos[i].fd = -1;
+        Trabajos[i].Buffer = NULL;
+        Trabajos[i].Tam_Buffer = 0;
+        Trabajos[i].Capacidad = 0;
+    }
+
+    int Activos[Max_Activos];
+    int Numero_Activos = 0;
+
+    while (Numero_Pendientes > 0 || Numero_Activos > 0)
+    {
+        // Lanzar evaluaciones hasta llenar el grupo de trabajadores
+        while (Numero_Activos < Max_Activos && Numero_Pendientes > 0)
         {
-            // Si se leyó un número flotante correctamente
-            Vector[i].FO = valor;
-            if (valor < FO_Mejor)
+            int t = Pendientes[Cabeza];
+            Cabeza = (Cabeza + 1) % Numero_Trabajos;
+            Numero_Pendientes--;
+            if (Lanzar_Evaluacion(instancia, &Trabajos[t]))
             {
-                FO_Mejor = valor;
+                Activos[Numero_Activos++] = t;
+            }
+            else
+            {
+                printf("Error: no se pudo lanzar la evaluacion %d (tipo %d).\n", Trabajos[t].Indice, Trabajos[t].Tipo_Evaluacion);
+                Trabajos[t].Individuo->FO = FO_PENALIZACION;
             }
-            
-            printf("\nValor FO: %f\n", Vector[i].FO);
-            printf("Tipo Evaluacion: %d\n", Tipo_Evaluacion);
-            printf("Numero de iteracion: %d\n", i);
         }
-        else
+        if (Numero_Activos == 0)
         {
-            // Si no se pudo leer un número flotante, intenta leer una cadena
-            fseek(FO, 0, SEEK_SET); // Reiniciar la posición del archivo
-            if (fscanf(FO, "%99[^\n]", mensaje) == 1)
+            continue;
+        }
+
+        // Esperar datos de cualquier canal hasta el tiempo limite más cercano
+        struct pollfd Canales[Max_Activos];
+        double Ahora = Tiempo_Actual();
+        double Espera = TIEMPO_LIMITE_EVALUACION;
+        for (int a = 0; a < Numero_Activos; a++)
+        {
+            Canales[a].fd = Trabajos[Activos[a]].fd;
+            Canales[a].events = POLLIN;
+            Canales[a].revents = 0;
+            double Restante = Trabajos[Activos[a]].Inicio + TIEMPO_LIMITE_EVALUACION - Ahora;
+            if (Restante < Espera)
             {
-                // Si se leyó una cadena correctamente
-                if (strcmp(mensaje, "Error: Violacion de segmento. El programa se detuvo inesperadamente.") == 0)
+                Espera = Restante;
+            }
+        }
+        if (poll(Canales, Numero_Activos, Espera > 0 ? (int)(Espera * 1000) + 1 : 0) < 0 && errno != EINTR)
+        {
+            perror("poll");
+            break;
+        }
+
+        Ahora = Tiempo_Actual();
+        for (int a = Numero_Activos - 1; a >= 0; a--)
+        {
+            Evaluacion *Trabajo = &Trabajos[Activos[a]];
+            bool Termino = false;
+            bool Agotado = false;
+
+            if (Canales[a].revents != 0)
+            {
+                // Leer lo que haya en el canal, EOF significa que el trabajador terminó
+                if (Trabajo->Capacidad - Trabajo->Tam_Buffer < 4096)
+                {
+                    size_t Nueva = Trabajo->Capacidad * 2 + 4096;
+                    char *Buffer = realloc(Trabajo->Buffer, Nueva);
+                    if (Buffer == NULL)
+                    {
+                        perror("realloc");
+                        exit(EXIT_FAILURE);
+                    }
+                    Trabajo->Buffer = Buffer;
+                    Trabajo->Capacidad = Nueva;
+                }
+                ssize_t n = read(Trabajo->fd, Trabajo->Buffer + Trabajo->Tam_Buffer, Trabajo->Capacidad - Trabajo->Tam_Buffer);
+                if (n > 0)
                 {
-                    printf("Error: Violacion de segmento. El programa se detuvo inesperadamente.\n");
-                    i--;
-                    //system("pause");
+                    Trabajo->Tam_Buffer += (size_t)n;
                 }
+                else if (n == 0 || errno != EINTR)
+                {
+                    Termino = true;
+                }
+            }
+            if (!Termino && Ahora - Trabajo->Inicio >= TIEMPO_LIMITE_EVALUACION)
+            {
+                printf("Error: la evaluacion %d (tipo %d) supero el tiempo limite de %.0f s.\n", Trabajo->Indice, Trabajo->Tipo_Evaluacion, TIEMPO_LIMITE_EVALUACION);
+                Agotado = true;
+            }
+            if (!Termino && !Agotado)
+            {
+                continue;
+            }
+
+            Resultado_Colonia Resultado;
+            if (Cerrar_Evaluacion(Trabajo, Agotado, &Resultado))
+            {
+                Registrar_Evaluacion(Trabajo, &Resultado, &FO_Mejor);
+                Liberar_Resultado(&Resultado);
+            }
+            else if (Trabajo->Intentos <= MAX_REINTENTOS)
+            {
+                // Volver a formar la evaluación, se lanzará con otra semilla
+                Pendientes[(Cabeza + Numero_Pendientes) % Numero_Trabajos] = Activos[a];
+                Numero_Pendientes++;
             }
             else
             {
-                printf("Error al leer el archivo.\n");
+                printf("Error: la evaluacion %d (tipo %d) fallo %d veces, se penaliza.\n", Trabajo->Indice, Trabajo->Tipo_Evaluacion, Trabajo->Intentos);
+                Trabajo->Individuo->FO = FO_PENALIZACION;
             }
+
+            // Sacar la evaluación del grupo de activos
+            Activos[a] = Activos[--Numero_Activos];
         }
+    }
 
-        fclose(FO);
-        // Guardar el FO_Mejor en un archivo de texto
-        FILE *FO_Mejor_Archivo;
-        FO_Mejor_Archivo = fopen("FuncionObjetivo/FO_Mejor.txt", "w");
-        if (FO_Mejor_Archivo == NULL)
+    for (int i = 0; i < Numero_Trabajos; i++)
+    {
+        free(Trabajos[i].Buffer);
+        Trabajos[i].Buffer = NULL;
+    }
+
+    // Guardar el FO_Mejor en un archivo de texto
+    FILE *FO_Mejor_Archivo = fopen("FuncionObjetivo/FO_Mejor.txt", "w");
+    if (FO_Mejor_Archivo == NULL)
+    {
+        printf("Error al abrir el archivo.\n");
+        return;
+    }
+    fprintf(FO_Mejor_Archivo, "%f", FO_Mejor);
+    fclose(FO_Mejor_Archivo);
+}
+#else
+// En Windows no hay fork, las evaluaciones se ejecutan una tras otra en este mismo proceso
+void Evaluar_FO(const Instancia *instancia, Evaluacion *Trabajos, int Numero_Trabajos)
+{
+    float FO_Mejor = FO_PENALIZACION; // Inicializar la función objetivo mejor con un valor muy grande
+    for (int i = 0; i < Numero_Trabajos; i++)
+    {
+        Configuracion_Colonia Configuracion = Configurar_Colonia(Trabajos[i].Individuo);
+        Resultado_Colonia Resultado;
+        if (Resolver_Colonia(instancia, &Configuracion, &Resultado, NULL, NULL) != 0)
         {
-            printf("Error al abrir el archivo.\n");
-            //return 1;
+            printf("Error al evaluar la colonia de hormigas.\n");
+            Trabajos[i].Individuo->FO = FO_PENALIZACION;
+            continue;
         }
-        fprintf(FO_Mejor_Archivo, "%f", FO_Mejor);
-        fclose(FO_Mejor_Archivo);
-        
+        Registrar_Evaluacion(&Trabajos[i], &Resultado, &FO_Mejor);
+        Liberar_Resultado(&Resultado);
+    }
 
-        // system("pause");
+    // Guardar el FO_Mejor en un archivo de texto
+    FILE *FO_Mejor_Archivo = fopen("FuncionObjetivo/FO_Mejor.txt", "w");
+    if (FO_Mejor_Archivo == NULL)
+    {
+        printf("Error al abrir el archivo.\n");
+        return;
     }
+    fprintf(FO_Mejor_Archivo, "%f", FO_Mejor);
+    fclose(FO_Mejor_Archivo);
+}
+#endif
+
+// Agrega a la lista de evaluaciones todos los individuos de una población
+static int Agregar_Poblacion(Evaluacion *Trabajos, int Numero_Trabajos, Parametros *Vector, int Tam_Poblacion, int Tipo_Evaluacion)
+{
+    for (int i = 0; i < Tam_Poblacion; i++)
+    {
+        Trabajos[Numero_Trabajos].Individuo = &Vector[i];
+        Trabajos[Numero_Trabajos].Indice = i;
+        Trabajos[Numero_Trabajos].Tipo_Evaluacion = Tipo_Evaluacion;
+        Numero_Trabajos++;
+    }
+    return Numero_Trabajos;
 }
 
 // Función para generar valores aleatorios
@@ -374,7 +714,7 @@ void Actualizar_Tipo_Evaluacion(Parametros *Vector, int Tam_Poblacion, int Tipo_
 }
 
 // Función principal
-int main()
+int main(int argc, char *argv[])
 {
     // Definir las variables
     int Tam_Poblacion = 10;
@@ -388,6 +728,13 @@ int main()
     Parametros Vector_Ruidoso[Tam_Poblacion];
     Parametros Vector_Prueba[Tam_Poblacion];
 
+    // Cargar la instancia una sola vez para todas las evaluaciones
+    Instancia *instancia = Cargar_Instancia(argc > 1 ? argv[1] : INSTANCIA);
+    if (instancia == NULL)
+    {
+        return 1;
+    }
+
     // Bucle para realizar las iteraciones
     for (int i = 0; i < Numero_Iteraciones_Max; i++)
     {
@@ -413,10 +760,13 @@ int main()
         Inicializar_Prueba(Vector_Prueba, Vector_Objetivo, Vector_Ruidoso, Tam_Poblacion, Factor_Cuza);
         // Test_Imprimir_Vector(Vector_Prueba, Tam_Poblacion);
 
-        // Evaluar la función objetivo de los vectores objetivo, ruidoso y de prueba
-        Evaluar_FO(Vector_Objetivo, Tam_Poblacion, 1);
-        Evaluar_FO(Vector_Ruidoso, Tam_Poblacion, 2);
-        Evaluar_FO(Vector_Prueba, Tam_Poblacion, 3);
+        // Evaluar la función objetivo de los vectores objetivo, ruidoso y de prueba, todas en el mismo grupo de trabajadores
+        Evaluacion Trabajos[3 * Tam_Poblacion];
+        int Numero_Trabajos = 0;
+        Numero_Trabajos = Agregar_Poblacion(Trabajos, Numero_Trabajos, Vector_Objetivo, Tam_Poblacion, 1);
+        Numero_Trabajos = Agregar_Poblacion(Trabajos, Numero_Trabajos, Vector_Ruidoso, Tam_Poblacion, 2);
+        Numero_Trabajos = Agregar_Poblacion(Trabajos, Numero_Trabajos, Vector_Prueba, Tam_Poblacion, 3);
+        Evaluar_FO(instancia, Trabajos, Numero_Trabajos);
 
         // Actualizar el vector objetivo con el vector de prueba si es necesario
         Actualizar_Vector_Objetivo(Vector_Objetivo, Vector_Prueba, Tam_Poblacion);
@@ -426,5 +776,6 @@ int main()
 
     // Imprimir el vector objetivo final
     Test_Imprimir_Vector(Vector_Objetivo, Tam_Poblacion);
+    Liberar_Instancia(instancia);
     return 0;
 }
@@ -0,0 +1,316 @@
+// Autor: Williams Chan Pescador
+// Algorithm: Colonias de Hormigas para el VRP con ventanas de tiempo
+// Description: Benchmark de la colonia sobre un conjunto fijo de instancias de Solomon (una por clase: C1, C2, R1, R2, RC1, RC2)
+//              con parámetros y semillas fijas. Mide iteraciones por segundo, pasos de construcción por segundo, el tiempo
+//              para llegar a una brecha objetivo contra el .sol y la brecha final, y los compara con una línea base guardada
+//              marcando las regresiones que pasen del umbral. Termina con estado 2 si hubo alguna regresión
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "Colonia_Hormigas.h"
+
+// Brecha en porcentaje contra la mejor solución conocida a la que se mide el tiempo para llegar
+#ifndef BRECHA_OBJETIVO
+#define BRECHA_OBJETIVO 5.0
+#endif
+
+// Fracción que puede empeorar el rendimiento (o crecer el tiempo al objetivo) antes de marcarlo como regresión
+#ifndef UMBRAL_REGRESION
+#define UMBRAL_REGRESION 0.10
+#endif
+
+// Puntos porcentuales que puede crecer la brecha final antes de marcarla como regresión
+#ifndef UMBRAL_BRECHA
+#define UMBRAL_BRECHA 1.0
+#endif
+
+// Diferencias de tiempo más chicas que esto (segundos) son ruido de medición
+#define TOLERANCIA_TIEMPO 0.005
+
+#define NUMERO_SEMILLAS 5
+#define LINEA_BASE "Benchmark/Linea_Base.csv"
+#define RESULTADOS "Benchmark/Resultados.csv"
+
+// Una instancia por clase; en las R1 y RC1 se usan las que el modelo sin espera sí puede resolver
+static const char *Instancias_Benchmark[] = {
+    "Instancias/Vrp-Set-Solomon/C101.txt",
+    "Instancias/Vrp-Set-Solomon/C201.txt",
+    "Instancias/Vrp-Set-Solomon/R112.txt",
+    "Instancias/Vrp-Set-Solomon/R211.txt",
+    "Instancias/Vrp-Set-Solomon/RC108.txt",
+    "Instancias/Vrp-Set-Solomon/RC208.txt",
+};
+#define NUMERO_INSTANCIAS (int)(sizeof(Instancias_Benchmark) / sizeof(Instancias_Benchmark[0]))
+
+// Métricas de una instancia. El rendimiento es el de la semilla más rápida (la corrida con menos ruido de la máquina),
+// el tiempo al objetivo y la brecha son el promedio de las semillas
+typedef struct
+{
+    char Nombre[50];
+    double Iteraciones_Segundo;
+    double Pasos_Segundo;
+    double Tiempo_Objetivo; // Segundos para llegar a BRECHA_OBJETIVO, INFINITY si alguna semilla no llegó
+    double Brecha_Final;    // Porcentaje contra el .sol, NAN si alguna semilla no encontró solución o no hay .sol
+} Medicion;
+
+// Estado de una corrida que lleva el observador
+typedef struct
+{
+    double Inicio;
+    double Distancia_Objetivo; // Distancia que corresponde a la brecha objetivo
+    double Tiempo_Objetivo;
+} Seguimiento;
+
+// Tiempo monotónico en segundos
+static double Tiempo_Actual(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+// Registra la primera iteración en la que la mejor solución llega a la brecha objetivo
+static void Observar_Iteracion(int Iteracion, const Resultado_Colonia *Mejor, const Feromonas_Colonia *feromonas, void *Datos)
+{
+    (void)Iteracion;
+    (void)feromonas;
+    Seguimiento *seguimiento = Datos;
+    if (!isfinite(seguimiento->Tiempo_Objetivo) && Mejor->Mejor_Distancia <= seguimiento->Distancia_Objetivo)
+    {
+        seguimiento->Tiempo_Objetivo = Tiempo_Actual() - seguimiento->Inicio;
+    }
+}
+
+static bool Medir_Instancia(const char *Ruta, const Configuracion_Colonia *Base, Medicion *medicion)
+{
+    Instancia *instancia = Cargar_Instancia(Ruta);
+    if (instancia == NULL)
+    {
+        return false;
+    }
+    snprintf(medicion->Nombre, sizeof(medicion->Nombre), "%s", instancia->nombre);
+
+    Resultado_Colonia Conocida;
+    double Distancia_Conocida = NAN;
+    if (Buscar_Solucion_Conocida(Ruta, instancia, &Conocida))
+    {
+        Distancia_Conocida = Conocida.Mejor_Distancia;
+        Liberar_Resultado(&Conocida);
+    }
+
+    double Brecha = 0, Tiempo_Objetivo = 0;
+    medicion->Iteraciones_Segundo = 0;
+    medicion->Pasos_Segundo = 0;
+    for (unsigned int Semilla = 1; Semilla <= NUMERO_SEMILLAS; Semilla++)
+    {
+        Configuracion_Colonia Configuracion = *Base;
+        Configuracion.Semilla = Semilla;
+        Seguimiento seguimiento = {Tiempo_Actual(), Distancia_Conocida * (1 + BRECHA_OBJETIVO / 100), INFINITY};
+        Resultado_Colonia Resultado;
+        if (Resolver_Colonia(instancia, &Configuracion, &Resultado, Observar_Iteracion, &seguimiento) != 0)
+        {
+            Liberar_Instancia(instancia);
+            return false;
+        }
+        double Tiempo = Tiempo_Actual() - seguimiento.Inicio;
+        medicion->Iteraciones_Segundo = fmax(medicion->Iteraciones_Segundo, Configuracion.Numero_Iteraciones / Tiempo);
+        medicion->Pasos_Segundo = fmax(medicion->Pasos_Segundo, Resultado.Pasos_Construccion / Tiempo);
+        Brecha += 100 * (Resultado.Mejor_Distancia - Distancia_Conocida) / Distancia_Conocida; // inf o NAN se propagan
+        Tiempo_Objetivo += seguimiento.Tiempo_Objetivo;
+        Liberar_Resultado(&Resultado);
+    }
+
+    medicion->Tiempo_Objetivo = Tiempo_Objetivo / NUMERO_SEMILLAS;
+    medicion->Brecha_Final = isfinite(Brecha) ? Brecha / NUMERO_SEMILLAS : NAN;
+    Liberar_Instancia(instancia);
+    return true;
+}
+
+// Un valor que no existe (objetivo no alcanzado, sin solución) se deja vacío en el CSV
+static void Escribir_Valor(FILE *archivo, double Valor)
+{
+    if (isfinite(Valor))
+    {
+        fprintf(archivo, "%.6f", Valor);
+    }
+}
+
+static bool Guardar_Mediciones(const char *Ruta, const Medicion *Mediciones, int Numero)
+{
+    FILE *archivo = fopen(Ruta, "w");
+    if (archivo == NULL)
+    {
+        fprintf(stderr, "No se pudo crear %s\n", Ruta);
+        return false;
+    }
+    fprintf(archivo, "instancia,iteraciones_s,pasos_s,tiempo_objetivo_s,brecha_final_pct\n");
+    for (int i = 0; i < Numero; i++)
+    {
+        fprintf(archivo, "%s,", Mediciones[i].Nombre);
+        Escribir_Valor(archivo, Mediciones[i].Iteraciones_Segundo);
+        fprintf(archivo, ",");
+        Escribir_Valor(archivo, Mediciones[i].Pasos_Segundo);
+        fprintf(archivo, ",");
+        Escribir_Valor(archivo, Mediciones[i].Tiempo_Objetivo);
+        fprintf(archivo, ",");
+        Escribir_Valor(archivo, Mediciones[i].Brecha_Final);
+        fprintf(archivo, "\n");
+    }
+    return fclose(archivo) == 0;
+}
+
+// Lee un campo numérico del renglón y avanza después de la coma; un campo vacío es INFINITY para los tiempos y NAN para la brecha
+static double Leer_Valor(char **Cursor, double Vacio)
+{
+    char *Fin;
+    double Valor = strtod(*Cursor, &Fin);
+    if (Fin == *Cursor)
+    {
+        Valor = Vacio;
+    }
+    *Cursor = Fin + strcspn(Fin, ",\n");
+    if (**Cursor == ',')
+    {
+        (*Cursor)++;
+    }
+    return Valor;
+}
+
+// Lee la línea base, devuelve el número de instancias leídas o -1 si no existe
+static int Cargar_Linea_Base(const char *Ruta, Medicion *Base, int Maximo)
+{
+    FILE *archivo = fopen(Ruta, "r");
+    if (archivo == NULL)
+    {
+        return -1;
+    }
+    char Renglon[512];
+    int Numero = 0;
+    bool Encabezado = true;
+    while (Numero < Maximo && fgets(Renglon, sizeof(Renglon), archivo) != NULL)
+    {
+        char *Coma = strchr(Renglon, ',');
+        if (Encabezado || Coma == NULL)
+        {
+            Encabezado = false;
+            continue;
+        }
+        Medicion *medicion = &Base[Numero++];
+        snprintf(medicion->Nombre, sizeof(medicion->Nombre), "%.*s", (int)(Coma - Renglon), Renglon);
+        char *Cursor = Coma + 1;
+        medicion->Iteraciones_Segundo = Leer_Valor(&Cursor, NAN);
+        medicion->Pasos_Segundo = Leer_Valor(&Cursor, NAN);
+        medicion->Tiempo_Objetivo = Leer_Valor(&Cursor, INFINITY);
+        medicion->Brecha_Final = Leer_Valor(&Cursor, NAN);
+    }
+    fclose(archivo);
+    return Numero;
+}
+
+// Compara una medición con su línea base, imprime cada regresión y devuelve cuántas encontró
+static int Comparar_Medicion(const Medicion *Actual, const Medicion *Base)
+{
+    int Regresiones = 0;
+    if (Actual->Iteraciones_Segundo < Base->Iteraciones_Segundo * (1 - UMBRAL_REGRESION))
+    {
+        printf("  REGRESION %s: %.1f iteraciones/s contra %.1f de la linea base\n", Actual->Nombre, Actual->Iteraciones_Segundo, Base->Iteraciones_Segundo);
+        Regresiones++;
+    }
+    if (Actual->Pasos_Segundo < Base->Pasos_Segundo * (1 - UMBRAL_REGRESION))
+    {
+        printf("  REGRESION %s: %.0f pasos/s contra %.0f de la linea base\n", Actual->Nombre, Actual->Pasos_Segundo, Base->Pasos_Segundo);
+        Regresiones++;
+    }
+    if (isfinite(Base->Tiempo_Objetivo) && !(Actual->Tiempo_Objetivo <= Base->Tiempo_Objetivo * (1 + UMBRAL_REGRESION) + TOLERANCIA_TIEMPO))
+    {
+        printf("  REGRESION %s: %.3f s para la brecha objetivo contra %.3f s de la linea base\n", Actual->Nombre, Actual->Tiempo_Objetivo, Base->Tiempo_Objetivo);
+        Regresiones++;
+    }
+    if (!isnan(Base->Brecha_Final) && !(Actual->Brecha_Final <= Base->Brecha_Final + UMBRAL_BRECHA))
+    {
+        printf("  REGRESION %s: brecha final %.2f%% contra %.2f%% de la linea base\n", Actual->Nombre, Actual->Brecha_Final, Base->Brecha_Final);
+        Regresiones++;
+    }
+    return Regresiones;
+}
+
+int main(int argc, char *argv[])
+{
+    // Uso: ./Colonia_Benchmark [guardar] [--estrategia=as|mmas|acs] ... — con guardar las mediciones se vuelven la nueva línea base.
+    // La línea base es de AS, con otra estrategia la comparación dice si llega a la brecha objetivo en menos tiempo
+    Configuracion_Colonia Configuracion = {0};
+    Configurar_Estrategia(&Configuracion, ESTRATEGIA_AS);
+    argc = Separar_Opciones_Colonia(argc, argv, &Configuracion);
+    if (argc < 0)
+    {
+        return 1;
+    }
+    bool Guardar_Base = argc > 1 && strcmp(argv[1], "guardar") == 0;
+
+    // Parámetros fijos para que las corridas sean comparables entre versiones; un solo hilo para que el tiempo no dependa de la máquina
+    Configuracion.Alpha = 1;
+    Configuracion.Beta = 2;
+    Configuracion.Gamma = 1;
+    Configuracion.Rho = 0.1;
+    Configuracion.Numero_Iteraciones = 500;
+    Configuracion.Numero_Hormigas = 10;
+    Configuracion.Numero_Hilos = 1;
+    Configuracion.Hormigas_Busqueda_Local = HORMIGAS_BUSQUEDA_LOCAL;
+
+    Medicion Mediciones[NUMERO_INSTANCIAS];
+    printf("%-9s %14s %14s %16s %14s\n", "Instancia", "Iteraciones/s", "Pasos/s", "T. objetivo (s)", "Brecha final");
+    for (int i = 0; i < NUMERO_INSTANCIAS; i++)
+    {
+        if (!Medir_Instancia(Instancias_Benchmark[i], &Configuracion, &Mediciones[i]))
+        {
+            fprintf(stderr, "No se pudo medir %s\n", Instancias_Benchmark[i]);
+            return 1;
+        }
+        printf("%-9s %14.1f %14.0f %16.3f %13.2f%%\n", Mediciones[i].Nombre, Mediciones[i].Iteraciones_Segundo,
+               Mediciones[i].Pasos_Segundo, Mediciones[i].Tiempo_Objetivo, Mediciones[i].Brecha_Final);
+    }
+    printf("Brecha objetivo: %.1f%%, %d semillas, %d iteraciones, %d hormigas\n", BRECHA_OBJETIVO, NUMERO_SEMILLAS,
+           Configuracion.Numero_Iteraciones, Configuracion.Numero_Hormigas);
+
+    if (!Guardar_Mediciones(Guardar_Base ? LINEA_BASE : RESULTADOS, Mediciones, NUMERO_INSTANCIAS))
+    {
+        return 1;
+    }
+    if (Guardar_Base)
+    {
+        printf("Linea base guardada en %s\n", LINEA_BASE);
+        return 0;
+    }
+    printf("Resultados guardados en %s\n", RESULTADOS);
+
+    Medicion Base[NUMERO_INSTANCIAS];
+    int Numero_Base = Cargar_Linea_Base(LINEA_BASE, Base, NUMERO_INSTANCIAS);
+    if (Numero_Base < 0)
+    {
+        printf("No hay linea base en %s, se crea con: %s guardar\n", LINEA_BASE, argv[0]);
+        return 0;
+    }
+
+    int Regresiones = 0;
+    for (int i = 0; i < NUMERO_INSTANCIAS; i++)
+    {
+        for (int b = 0; b < Numero_Base; b++)
+        {
+            if (strcmp(Mediciones[i].Nombre, Base[b].Nombre) == 0)
+            {
+                Regresiones += Comparar_Medicion(&Mediciones[i], &Base[b]);
+            }
+        }
+    }
+    if (Regresiones > 0)
+    {
+        printf("%d regresiones contra la linea base (umbral %.0f%%, %.1f puntos de brecha)\n", Regresiones, UMBRAL_REGRESION * 100, UMBRAL_BRECHA);
+        return 2;
+    }
+    printf("Sin regresiones contra la linea base (umbral %.0f%%, %.1f puntos de brecha)\n", UMBRAL_REGRESION * 100, UMBRAL_BRECHA);
+    return 0;
+}
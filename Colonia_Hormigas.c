@@ -1,6 +1,7 @@
 // Autor: Williams Chan Pescador
 // Algorithm: Colonias de Hormigas para el VRP con ventanas de tiempo
 // Description: Este programa implementa el algoritmo de colonia de hormigas para resolver el problema de rutas de vehículos con capacidad y tiempo de servicio en cada cliente
+//              La colonia vive en Colonia_Hormigas_Lib.c, este archivo solo lee los argumentos y guarda los resultados
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
@@ -9,12 +10,16 @@
 #include <limits.h>
 #include <unistd.h>
 #include <signal.h>
-#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "Colonia_Hormigas.h"
 
 // Definir la semilla aleatoria dependiendo del sistema operativo
 #ifdef _WIN32
 #include <windows.h>
 #include <wincrypt.h>
+#include <psapi.h>
 
 // Función para obtener una semilla aleatoria en Windows
 unsigned int obtener_semilla_aleatoria()
@@ -40,7 +45,19 @@ unsigned int obtener_semilla_aleatoria()
     return semilla;
 }
 
+// Memoria máxima que ha ocupado el proceso en KB
+long memoria_maxima_kb()
+{
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+    {
+        return -1;
+    }
+    return (long)(pmc.PeakWorkingSetSize / 1024);
+}
+
 #else // Si no es Windows, asumimos que es un sistema basado en Unix/Linux
+#include <sys/resource.h>
 
 // Función para obtener una semilla aleatoria en sistemas basados en Unix/Linux
 unsigned int obtener_semilla_aleatoria()
@@ -61,898 +78,467 @@ unsigned int obtener_semilla_aleatoria()
     return semilla;
 }
 
-#endif
-
-// Definir el numero maximo de clientes
-#define MAX_CUSTOMERS 101
-
-// Parámetros de la colonia de hormigas
-double Alpha;
-double Beta;
-double Rho;
-double Gamma;
-
-// Estructura para representar un vehículo
-typedef struct
+// Memoria máxima que ha ocupado el proceso en KB
+long memoria_maxima_kb()
 {
-    int number;              // Número identificador del vehículo
-    int capacity;            // Capacidad del vehículo
-    int capacity_restant;    // Capacidad restante del vehiculo
-    double Tiempo_Consumido; // Tiempo que ha consumido en recorrer los cliente y atenderlos
-    double Tiempo_Maximo;    // Maximo de tiempo para regresar al deposito
-} Vehicle;
-
-typedef struct
-{
-    int Cliente;              // Número identificador del cliente
-    double xCoord;            // Coordenada X del cliente en el plano
-    double yCoord;            // Coordenada Y del cliente en el plano
-    int Demanda;              // Cantidad demandada por el cliente
-    double Tiempo_Inicio;     // Tiempo de inicio permitido para el servicio
-    double Fecha_Vencimiento; // Fecha límite para el servicio
-    double Tiempo_Servicio;   // Tiempo necesario para atender al cliente
-} Customer;
-
-struct Nodo
-{
-    int dato;
-    struct Nodo *siguiente;
-};
-
-// Función para insertar un nuevo nodo al final de la lista
-void insertarAlFinal(struct Nodo **cabeza, int dato)
-{
-    // Crear un nuevo nodo
-    struct Nodo *nuevoNodo = (struct Nodo *)malloc(sizeof(struct Nodo));
-    nuevoNodo->dato = dato;
-    nuevoNodo->siguiente = NULL;
-
-    // Si la lista está vacía, el nuevo nodo se convierte en la cabeza de la lista
-    if (*cabeza == NULL)
+    struct rusage uso;
+    if (getrusage(RUSAGE_SELF, &uso) != 0)
     {
-        *cabeza = nuevoNodo;
-        return;
+        return -1;
     }
+#ifdef __APPLE__
+    return uso.ru_maxrss / 1024; // En macOS ru_maxrss viene en bytes
+#else
+    return uso.ru_maxrss;
+#endif
+}
 
-    // Recorrer la lista hasta el último nodo
-    struct Nodo *ultimo = *cabeza;
-    while (ultimo->siguiente != NULL)
-    {
-        ultimo = ultimo->siguiente;
-    }
+#endif
 
-    // Enlazar el nuevo nodo al final de la lista
-    ultimo->siguiente = nuevoNodo;
-}
+#ifdef ESTADISTICAS
+#include <sys/stat.h>
 
-// Función para imprimir los elementos de la lista
-void imprimirLista(struct Nodo *cabeza)
+// Tiempo monotónico en segundos para las estadísticas
+static double Tiempo_Monotonico(void)
 {
-    while (cabeza != NULL)
-    {
-        printf(" %d -> ", cabeza->dato);
-        cabeza = cabeza->siguiente;
-    }
-    printf("NULL\n");
-}
-// Función para imprimir la lista
-void imprimirListasCombinadas(struct Nodo *cabeza)
-{
-    struct Nodo *actual = cabeza;
-    while (actual != NULL)
-    {
-        printf("%d ", actual->dato);
-        actual = actual->siguiente;
-    }
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
 }
 
-// Función para imprimir la lista en formato CSV y guardarla en un archivo
-void guardarListaCSV(struct Nodo *cabeza, const char *nombreArchivo)
+// Tamaño en bytes de un archivo recién escrito, 0 si no existe
+static long long Tam_Archivo(const char *Ruta)
 {
-    // Abrir el archivo en modo de escritura
-    FILE *archivo = fopen(nombreArchivo, "a");
-    if (archivo == NULL)
-    {
-        printf("No se pudo abrir el archivo.\n");
-        return;
-    }
-
-    // Recorrer la lista y escribir en el archivo
-    while (cabeza != NULL)
-    {
-        fprintf(archivo, "%d", cabeza->dato); // Escribir el dato
-
-        if (cabeza->siguiente != NULL)
-        {
-            fprintf(archivo, ",");
-        }
-        else
-        {
-            fprintf(archivo, "\n");
-        }
-
-        cabeza = cabeza->siguiente;
-    }
-
-    // Cerrar el archivo
-    fclose(archivo);
+    struct stat Estado;
+    return stat(Ruta, &Estado) == 0 ? (long long)Estado.st_size : 0;
 }
+#endif
 
-// Matrices para almacenar feromonas y visibilidad entre clientes
-double feromonas[MAX_CUSTOMERS][MAX_CUSTOMERS];
-double visibilidad[MAX_CUSTOMERS][MAX_CUSTOMERS];
-
-// Funcion para inizializar la matriz de feromonas
-void inicializar_feromonas(int size)
+#ifdef ESTADISTICAS
+// Renglón de la traza por iteración: la colonia lo copia al buzón y el escritor lo escribe
+typedef struct
 {
-    for (int i = 0; i < size; i++)
-    {
-        for (int j = 0; j < size; j++)
-        {
-            if (i != j)
-            {
-                feromonas[i][j] = 1.0; // 1 en toda la matriz excepto la diagonal
-            }
-            else
-            {
-                feromonas[i][j] = 0.0; // La diagonal debe ser cero
-            }
-        }
-    }
-}
+    int Iteracion;
+    double Mejor_Distancia;
+    int Numero_Rutas;
+    long long Pasos_Construccion;
+    Estadisticas_Colonia Estadisticas;
+} Renglon_Traza;
+#endif
 
-void Guardar_Visibilidad()
+// Escritor en segundo plano: el hilo de la colonia solo copia lo que hay que guardar a un buzón y el hilo escritor hace toda la
+// salida a disco y a pantalla. Cada buzón guarda solo lo más reciente: si el escritor va atrasado la copia nueva sustituye a la
+// pendiente, así la cola nunca crece y la colonia nunca espera al disco. La última iteración siempre se escribe
+typedef struct
 {
-    FILE *archivo;
-    bool existe = false;
-
-    // Verifica si el archivo ya existe
-    if ((archivo = fopen("MatricesF&V/Matriz_Visibilidad.csv", "r")) != NULL)
-    {
-        existe = true;
-        fclose(archivo);
-    }
-
-    // Abre el archivo en modo de escritura (creará uno nuevo si no existe)
-    archivo = fopen("MatricesF&V/Matriz_Visibilidad.csv", "w");
-
-    if (archivo == NULL)
-    {
-        printf("Error al crear el archivo.\n");
-        return;
-    }
-
-    // Escribe la matriz de feromonas en el archivo CSV
-    for (int i = 0; i < MAX_CUSTOMERS; i++)
-    {
-        for (int j = 0; j < MAX_CUSTOMERS; j++)
-        {
-            fprintf(archivo, "%lf", visibilidad[i][j]);
-            if (j != MAX_CUSTOMERS - 1)
-            {
-                fprintf(archivo, ",");
-            }
-        }
-        fprintf(archivo, "\n");
-    }
-
-    fclose(archivo);
+    pthread_t Hilo;
+    pthread_mutex_t Candado;
+    pthread_cond_t Hay_Trabajo;
+    bool Terminar;                              // La colonia terminó, se vacían los buzones y el hilo sale
+
+    const char *Route_Archive;                  // Archivo CSV de la mejor ruta
+    const Instancia *instancia;                 // Instancia que se está resolviendo
+    const Configuracion_Colonia *Configuracion; // Parámetros de la ejecución, se guardan en el encabezado de las matrices
+    int Instantanea_Cada;                       // Cada cuántas iteraciones se guarda la matriz de feromonas, 0 = solo al final
+
+    // Buzón de la mejor solución, el escritor intercambia Ruta_Pendiente con Ruta_Escribiendo
+    bool Hay_Ruta;
+    Resultado_Colonia Ruta_Pendiente;
+    Resultado_Colonia Ruta_Escribiendo;
+
+    // Buzón de la matriz de feromonas, igual con dos matrices
+    bool Hay_Feromonas;
+    int Iteracion_Feromonas;
+    double *Feromonas_Pendientes;
+    double *Feromonas_Escribiendo;
+
+    int Sustituidas; // Instantáneas que se sustituyeron antes de escribirse
+
+#ifdef ESTADISTICAS
+    long long Bytes_Escritos; // Bytes que el escritor guardó en disco
+    double Tiempo_Escritura;  // Segundos que el escritor pasó escribiendo
+    FILE *Traza;              // Traza por iteración, NULL si no se pidió; la escribe el escritor
+
+    // Buzón de la traza. A diferencia de los otros no se sustituye: se acumulan todos los renglones pendientes y el escritor
+    // intercambia los dos arreglos
+    Renglon_Traza *Traza_Pendiente;
+    int Renglones_Pendientes;
+    int Capacidad_Pendiente;
+    Renglon_Traza *Traza_Escribiendo;
+    int Capacidad_Escribiendo;
+    int Renglones_Perdidos; // Renglones que no cupieron porque no hubo memoria para crecer el buzón
+#endif
+} Escritor;
 
-    if (existe)
+// La visibilidad no cambia durante la ejecución, se guarda una vez al inicio
+void Guardar_Visibilidad(const Instancia *instancia, const Configuracion_Colonia *Configuracion)
+{
+    const char *Ruta = "MatricesF&V/Matriz_Visibilidad.bin";
+    if (Guardar_Matriz_Binaria(Ruta, MATRIZ_VISIBILIDAD, instancia->visibilidad, instancia, -1, Configuracion))
     {
-        printf("Matriz_Visibilidad actualizada exitosamente en Matriz_Feromonas.csv.\n");
+        printf("Matriz_Visibilidad guardada exitosamente en %s.\n", Ruta);
     }
     else
     {
-        printf("Matriz_Visibilidad guardada exitosamente en Matriz_Feromonas.csv.\n");
+        printf("Error al crear el archivo %s.\n", Ruta);
     }
 }
 
-void Guardar_Feromonas()
+void Guardar_Feromonas(const double *feromonas, int Iteracion, const Escritor *escritor)
 {
-    FILE *archivo;
-    bool existe = false;
-
-    // Verifica si el archivo ya existe
-    if ((archivo = fopen("MatricesF&V/Matriz_Feromonas.csv", "r")) != NULL)
+    const char *Ruta = "MatricesF&V/Matriz_Feromonas.bin";
+    if (Guardar_Matriz_Binaria(Ruta, MATRIZ_FEROMONAS, feromonas, escritor->instancia, Iteracion, escritor->Configuracion))
     {
-        existe = true;
-        fclose(archivo);
-    }
-
-    // Abre el archivo en modo de escritura (creará uno nuevo si no existe)
-    archivo = fopen("MatricesF&V/Matriz_Feromonas.csv", "w");
-
-    if (archivo == NULL)
-    {
-        printf("Error al crear el archivo.\n");
-        return;
-    }
-
-    // Escribe la matriz de feromonas en el archivo CSV
-    for (int i = 0; i < MAX_CUSTOMERS; i++)
-    {
-        for (int j = 0; j < MAX_CUSTOMERS; j++)
-        {
-            fprintf(archivo, "%lf", feromonas[i][j]);
-            if (j != MAX_CUSTOMERS - 1)
-            {
-                fprintf(archivo, ",");
-            }
-        }
-        fprintf(archivo, "\n");
-    }
-
-    fclose(archivo);
-
-    if (existe)
-    {
-        printf("Matriz de feromonas actualizada exitosamente en Matriz_Feromonas.csv.\n");
+        printf("Matriz de feromonas de la iteracion %d guardada exitosamente en %s.\n", Iteracion, Ruta);
     }
     else
     {
-        printf("Matriz de feromonas guardada exitosamente en Matriz_Feromonas.csv.\n");
+        printf("Error al crear el archivo %s.\n", Ruta);
     }
 }
 
-// Función para imprimir la matriz de feromonas
-void Visualizar_Feromonas()
+// Función para imprimir las rutas de un resultado
+void Imprimir_Rutas(const Resultado_Colonia *Resultado)
 {
-    printf("*******************************************Feromonas*******************************************\n");
-    for (int i = 0; i < MAX_CUSTOMERS; i++)
+    for (int r = 0; r < Resultado->Numero_Rutas; r++)
     {
-        for (int j = 0; j < MAX_CUSTOMERS; j++)
+        printf("Hormiga %d: ", r);
+        for (int i = Resultado->Inicio_Ruta[r]; i < Resultado->Inicio_Ruta[r + 1]; i++)
         {
-            printf("%.2lf\t", feromonas[i][j]);
+            printf(" %d -> ", Resultado->Nodos[i]);
         }
-        printf("\n");
+        printf("NULL\n");
     }
 }
 
-// Función para truncar un número a un solo decimal
-double TruncarAUnDecimal(double valor)
+// Función para manejar la señal SIGSEGV
+void manejador_segfault(int sig)
 {
-    return floor(valor * 10.0) / 10.0;
-}
+    (void)sig;
+    fprintf(stderr, "Error: Violacion de segmento. El programa se detuvo inesperadamente.\n");
+    FILE *archivo_m;
+    archivo_m = fopen("FuncionObjetivo/FO.txt", "w");
 
-// Función para inicializar la visibilidad entre clientes
-void inicializar_visibilidad(int size, Customer clientes[])
-{
-    // Inicialización de la matriz de visibilidad
-    for (int i = 0; i < size; i++)
+    if (archivo_m != NULL)
     {
-        for (int j = 0; j < size; j++)
-        {
-            if (i != j)
-            {
-                // Cálculo de la distancia euclidiana entre dos clientes
-                double distancia = sqrt(pow(clientes[i].xCoord - clientes[j].xCoord, 2) +
-                                        pow(clientes[i].yCoord - clientes[j].yCoord, 2));
-                visibilidad[i][j] = 1.0 / distancia; // Inversa de la distancia como visibilidad
-            }
-            else
-            {
-                visibilidad[i][j] = 0.0; // La diagonal debe ser cero
-            }
-        }
-    }
-}
+        // Escribe el valor en el archivo
+        fprintf(archivo_m, "Error: Violacion de segmento. El programa se detuvo inesperadamente.");
 
-// Función para retornar la distancia con respecto a los clientes que nos llegue, truncada a un decimal
-double Calcular_Distancia(Customer Origen, Customer Destino)
-{
-    double distancia = sqrt(pow(Origen.xCoord - Destino.xCoord, 2) + pow(Origen.yCoord - Destino.yCoord, 2));
-    return distancia;
-}
+        // Cierra el archivo
+        fclose(archivo_m);
+    }
 
-double Calcular_Tiempo_Recorrido(double Distancia)
-{
-    // printf("Distancia calcula: %lf\n", Distancia);
-    double Velocidad = 1;
-    double Tiempo = Distancia / Velocidad;
-    // printf("Tiempo calculado: %lf\n", Tiempo);
-    return Tiempo;
+    // Realizar cualquier acción necesaria, como registrar el error en un archivo de registro
+    exit(1); // Salir del programa con un código de error
 }
 
-// Función para imprimir la matriz de visibilidad
-void Visualiar_Visibilidad()
+// Copia un resultado sobre otro reutilizando sus arreglos
+static bool Copiar_Resultado(Resultado_Colonia *Destino, const Resultado_Colonia *Origen)
 {
-    printf("*******************************************Visibilidad*******************************************\n");
-    for (int i = 0; i < MAX_CUSTOMERS; i++)
+    int Total_Nodos = Origen->Numero_Rutas > 0 ? Origen->Inicio_Ruta[Origen->Numero_Rutas] : 0;
+    int *Nodos = realloc(Destino->Nodos, (Total_Nodos > 0 ? Total_Nodos : 1) * sizeof(int));
+    if (Nodos == NULL)
     {
-        for (int j = 0; j < MAX_CUSTOMERS; j++)
-        {
-            printf("%.4lf\t", visibilidad[i][j]);
-        }
-        printf("\n");
+        return false;
     }
-}
-// Función para verificar si la capacidad del vehículo permite atender al cliente de destino sin exceder la capacidad máxima
-bool Calculo_Capacidad(Customer Destino, Vehicle Vehiculo)
-{
-    if (Vehiculo.capacity_restant + Destino.Demanda > Vehiculo.capacity)
+    Destino->Nodos = Nodos;
+    int *Inicio_Ruta = realloc(Destino->Inicio_Ruta, (Origen->Numero_Rutas + 1) * sizeof(int));
+    if (Inicio_Ruta == NULL)
     {
         return false;
     }
-    return true;
-}
-// Función para calcular el numerador necesario para determinar la probabilidad de seleccionar un destino en la construcción de la ruta
-// Función para calcular el numerador necesario para determinar la probabilidad de seleccionar un destino en la construcción de la ruta
-double Calcular_Numerador(Customer Origen, Customer Destino, double Alpha, double Beta, double gamma)
-{
-    int Origen_Indice = Origen.Cliente;
-    int Destino_Indice = Destino.Cliente;
-
-    //(Origen,destino) de la matriz inversa de la distancia
-    double Valor_Visibilidad = visibilidad[Origen_Indice][Destino_Indice];
-    //(Origen,destino) de la matriz de feromonas
-    double Valor_Feromona = feromonas[Origen_Indice][Destino_Indice];
-
-    double tiempo_hasta_vencimiento = Destino.Fecha_Vencimiento;
-
-    // Ajusta la importancia de los tiempos
-    double Valor_Tiempos = (tiempo_hasta_vencimiento > 0) ? 1.0 / tiempo_hasta_vencimiento : 0.0;
-    // (Origen,destino)^Alpha*(1/(Origen,destino))^Beta = Numerador
-    double Numerador = pow(Valor_Feromona, Alpha) * pow(Valor_Visibilidad, Beta) * pow(Valor_Tiempos, gamma);
-    // printf("Numerador del cliente: %lf\n", Numerador);
-    // printf("Origen_Indice: %d\n", Origen_Indice);
-    // printf("Destino_Indice: %d\n", Destino_Indice);
-    // printf("Valor_Visibilidad: %lf\n", Valor_Visibilidad);
-    // printf("Valor_Feromona: %lf\n", Valor_Feromona);
-    return Numerador;
-}
+    Destino->Inicio_Ruta = Inicio_Ruta;
 
-float Generar_Valores(double Limite_Inferior, double Limite_Superior)
-{
-    //srand(obtener_semilla_aleatoria());
-    float Valor;
-    Valor = Limite_Inferior + ((float)rand() / RAND_MAX) * (Limite_Superior - Limite_Inferior);
-    return Valor;
+    if (Total_Nodos > 0)
+    {
+        memcpy(Destino->Nodos, Origen->Nodos, Total_Nodos * sizeof(int));
+        memcpy(Destino->Inicio_Ruta, Origen->Inicio_Ruta, (Origen->Numero_Rutas + 1) * sizeof(int));
+    }
+    Destino->Inicio_Ruta[0] = 0;
+    Destino->Numero_Rutas = Origen->Numero_Rutas;
+    Destino->Mejor_Distancia = Origen->Mejor_Distancia;
+    Destino->Pasos_Construccion = Origen->Pasos_Construccion;
+    Destino->Estadisticas = Origen->Estadisticas;
+    return true;
 }
 
-// Función donde selecciona un índice basado en las probabilidades acumuladas y genera un número aleatorio para tomar una decisión
-int Seleccion_Parte(double *Probabilidades, int Num_Probabilidades)
+// Hilo escritor: espera a que haya algo en los buzones, lo toma y lo escribe sin tener el candado
+static void *Ejecutar_Escritor(void *Argumento)
 {
-    // Inicializa la semilla para la función rand() con el tiempo actual
-    // srand(obtener_semilla_aleatoria());
-    srand((unsigned int)time(NULL));
-
-    // Genera un número aleatorio en el rango [0, RAND_MAX]
-    int numeroAleatorio = rand() % 100;
-
-    // Normaliza el número aleatorio en el rango [0, 1)
-    // double Aleatorio = Generar_Valores(0, 1);
-    double Aleatorio = (double)numeroAleatorio / 100;
-
-    // printf("Numero Aleatorio: %lf\n", Aleatorio);
-    //  system("pause");
-
-    // Variable para guardar el valor siguiente al aleatorio
-    double Sig_Mayor;
-    // Pos del cliente elegido
-    int Posicion_Cliente_Elegido;
+    Escritor *escritor = Argumento;
 
-    for (size_t i = 0; i < Num_Probabilidades; ++i)
+    pthread_mutex_lock(&escritor->Candado);
+    while (true)
     {
-        if (Probabilidades[i] > Aleatorio)
+        bool Hay_Traza = false;
+#ifdef ESTADISTICAS
+        Hay_Traza = escritor->Renglones_Pendientes > 0;
+#endif
+        while (!escritor->Terminar && !escritor->Hay_Ruta && !escritor->Hay_Feromonas && !Hay_Traza)
+        {
+            pthread_cond_wait(&escritor->Hay_Trabajo, &escritor->Candado);
+#ifdef ESTADISTICAS
+            Hay_Traza = escritor->Renglones_Pendientes > 0;
+#endif
+        }
+        if (!escritor->Hay_Ruta && !escritor->Hay_Feromonas && !Hay_Traza)
         {
-            Sig_Mayor = Probabilidades[i];
-            // Guarda la pos del cliente que se eligio
-            Posicion_Cliente_Elegido = i;
             break;
         }
-    }
-    // printf("Numero Aleatorio: %lf\n", Aleatorio);
-    // printf("Numero Mayor: %lf\n", Sig_Mayor);
-    // printf("Indice del cliente elegido: %d\n", Posicion_Cliente_Elegido);
-    return Posicion_Cliente_Elegido;
-}
-
-// Función donde calcula las probabilidades acumuladas para seleccionar un destino durante la construcción de la ruta
-double *Probabilidad(double *Numeradores, int Num_Numeradores, double Denominador)
-{
-    double *Probabilidades = malloc(Num_Numeradores * sizeof(double));
-
-    if (Probabilidades == NULL)
-    {
-        // Manejo de error en caso de que no se pueda asignar memoria
-        fprintf(stderr, "Error al asignar memoria\n");
-        exit(EXIT_FAILURE);
-    }
 
-    // Cálculo de probabilidades acumuladas
-    for (size_t i = 0; i < Num_Numeradores; ++i)
-    {
-        if (i == 0)
+        // Toma lo pendiente intercambiando las copias, la colonia puede dejar la siguiente mientras se escribe esta
+        bool Escribir_Ruta = escritor->Hay_Ruta;
+        bool Escribir_Feromonas = escritor->Hay_Feromonas;
+        int Iteracion_Feromonas = escritor->Iteracion_Feromonas;
+        if (Escribir_Ruta)
         {
-            Probabilidades[i] = (Numeradores[i] / Denominador);
+            Resultado_Colonia Temporal = escritor->Ruta_Escribiendo;
+            escritor->Ruta_Escribiendo = escritor->Ruta_Pendiente;
+            escritor->Ruta_Pendiente = Temporal;
+            escritor->Hay_Ruta = false;
         }
-        Probabilidades[i] = (Numeradores[i] / Denominador) + Probabilidades[i - 1];
-        // printf("Probabilidades: %lf\n", Probabilidades[i]);
-        // printf("Numerador: %lf\n", (Numeradores[i] / Denominador));
-    }
-
-    return Probabilidades;
-}
-
-// Función para imprimr datos del cliente
-void Imprimir_Customer(Customer cliente)
-{
-    printf("Cliente: %d\n", cliente.Cliente);
-    printf("Coordenadas: (%lf, %lf)\n", cliente.xCoord, cliente.yCoord);
-    printf("Demanda: %d\n", cliente.Demanda);
-    printf("Tiempo de inicio permitido: %lf\n", cliente.Tiempo_Inicio);
-    printf("Fecha limite para el servicio: %lf\n", cliente.Fecha_Vencimiento);
-    printf("Tiempo de servicio necesario: %lf\n", cliente.Tiempo_Servicio);
-    printf("\n");
-}
+        if (Escribir_Feromonas)
+        {
+            double *Temporal = escritor->Feromonas_Escribiendo;
+            escritor->Feromonas_Escribiendo = escritor->Feromonas_Pendientes;
+            escritor->Feromonas_Pendientes = Temporal;
+            escritor->Hay_Feromonas = false;
+        }
+#ifdef ESTADISTICAS
+        int Renglones = escritor->Renglones_Pendientes;
+        if (Renglones > 0)
+        {
+            Renglon_Traza *Temporal = escritor->Traza_Escribiendo;
+            int Capacidad = escritor->Capacidad_Escribiendo;
+            escritor->Traza_Escribiendo = escritor->Traza_Pendiente;
+            escritor->Capacidad_Escribiendo = escritor->Capacidad_Pendiente;
+            escritor->Traza_Pendiente = Temporal;
+            escritor->Capacidad_Pendiente = Capacidad;
+            escritor->Renglones_Pendientes = 0;
+        }
+#endif
+        pthread_mutex_unlock(&escritor->Candado);
 
-// Funcion verifica si un índice específico está presente en la lista Tabú.
-bool Validar_Tabu_Indice(struct Nodo *cabeza, int Indice)
-{
-    // Recorre la lista Tabú
-    while (cabeza != NULL)
-    {
-        // Compara el índice actual con el índice proporcionado
-        if (cabeza->dato == Indice)
+#ifdef ESTADISTICAS
+        double Inicio_Escritura = Tiempo_Monotonico();
+#endif
+        if (Escribir_Feromonas)
         {
-            // El índice está presente en la lista Tabú
-            return true;
+            Guardar_Feromonas(escritor->Feromonas_Escribiendo, Iteracion_Feromonas, escritor);
+#ifdef ESTADISTICAS
+            escritor->Bytes_Escritos += Tam_Archivo("MatricesF&V/Matriz_Feromonas.bin");
+#endif
         }
-        // Avanza al siguiente nodo en la lista Tabú
-        cabeza = cabeza->siguiente;
-    }
+        if (Escribir_Ruta)
+        {
+            // Impresión de la mejor distancia total y las mejores rutas encontradas hasta el momento
+            printf("\n\nMejor Distancia Total(FO): %lf\n", escritor->Ruta_Escribiendo.Mejor_Distancia);
+            printf("Mejor Ruta:\n");
+            Imprimir_Rutas(&escritor->Ruta_Escribiendo);
+            Guardar_Rutas_CSV(&escritor->Ruta_Escribiendo, escritor->Route_Archive);
+#ifdef ESTADISTICAS
+            escritor->Bytes_Escritos += Tam_Archivo(escritor->Route_Archive);
+#endif
+        }
+#ifdef ESTADISTICAS
+        // Un renglón por iteración con los acumulados hasta esa iteración
+        for (int k = 0; k < Renglones && escritor->Traza != NULL; k++)
+        {
+            const Renglon_Traza *t = &escritor->Traza_Escribiendo[k];
+            const Estadisticas_Colonia *e = &t->Estadisticas;
+            fprintf(escritor->Traza, "%d,%f,%d,%lld,%f,%f,%f,%f,%f,%f,%f,%lld,%lld,%lld,%lld,%lld,%lld,%lld,%lld\n", t->Iteracion,
+                    t->Mejor_Distancia, t->Numero_Rutas, t->Pasos_Construccion, e->Tiempo_Construccion, e->Tiempo_Distancia,
+                    e->Tiempo_Seleccion, e->Tiempo_Feromonas, e->Tiempo_Atractivo, e->Tiempo_Observador, e->Tiempo_Busqueda_Local,
+                    e->Candidatos_Revisados, e->Candidatos_Factibles, e->Revisiones_Completas, e->Rutas_Abiertas,
+                    e->Hormigas_Incompletas, e->Movimientos_Evaluados, e->Movimientos_Aplicados, e->Reinicios);
+        }
+        escritor->Tiempo_Escritura += Tiempo_Monotonico() - Inicio_Escritura;
+#endif
 
-    return false;
+        pthread_mutex_lock(&escritor->Candado);
+    }
+    pthread_mutex_unlock(&escritor->Candado);
+    return NULL;
 }
 
-// Función devuelve el último índice presente en la lista Tabú.
-int Ultimo_Indice(struct Nodo *cabeza)
+// Prepara los buzones y lanza el hilo escritor
+static bool Iniciar_Escritor(Escritor *escritor, const Instancia *instancia, const Configuracion_Colonia *Configuracion,
+                             const char *Route_Archive, int Instantanea_Cada)
 {
-    // Recorre la lista Tabú hasta el último nodo
-    while (cabeza->siguiente != NULL)
+    memset(escritor, 0, sizeof(*escritor));
+    escritor->instancia = instancia;
+    escritor->Configuracion = Configuracion;
+    escritor->Route_Archive = Route_Archive;
+    escritor->Instantanea_Cada = Instantanea_Cada;
+    escritor->Feromonas_Pendientes = Reservar_Matriz(instancia->Numero_Clientes);
+    escritor->Feromonas_Escribiendo = Reservar_Matriz(instancia->Numero_Clientes);
+    if (escritor->Feromonas_Pendientes == NULL || escritor->Feromonas_Escribiendo == NULL)
     {
-        // Avanza al siguiente nodo en la lista Tabú
-        cabeza = cabeza->siguiente;
+        Liberar_Matriz(escritor->Feromonas_Pendientes);
+        Liberar_Matriz(escritor->Feromonas_Escribiendo);
+        return false;
     }
-    // Devuelve el último índice en la lista Tabú
-    return cabeza->dato;
-}
-
-int SiguienteAleatorioEnteroModN(long *semilla, int n)
-// DEVUELVE UN ENTERO ENTRE 0 Y n-1
-{
-    double a;
-    int v;
-    long double zi, mhi31 = 2147483648u, ahi31 = 314159269u, chi31 = 453806245u;
-    long int dhi31;
-    zi = *semilla;
-    zi = (ahi31 * zi) + chi31;
-    if (zi > mhi31)
+    pthread_mutex_init(&escritor->Candado, NULL);
+    pthread_cond_init(&escritor->Hay_Trabajo, NULL);
+    if (pthread_create(&escritor->Hilo, NULL, Ejecutar_Escritor, escritor) != 0)
     {
-        dhi31 = (long int)(zi / mhi31);
-        zi = zi - (dhi31 * mhi31);
+        pthread_mutex_destroy(&escritor->Candado);
+        pthread_cond_destroy(&escritor->Hay_Trabajo);
+        Liberar_Matriz(escritor->Feromonas_Pendientes);
+        Liberar_Matriz(escritor->Feromonas_Escribiendo);
+        return false;
     }
-    *semilla = (long int)zi;
-    zi = zi / mhi31;
-    a = zi;
-    v = (int)(a * n);
-    if (v == n)
-        return (v - 1);
-    return (v);
+    return true;
 }
 
-// Función para la construcción de rutas utilizando el algoritmo de colonia de hormigas
-bool Calculo_Probabilidad(Customer *Destinos, struct Nodo **Tabu, struct Nodo **Tabu_Vehiculo, int num_hormigas, int num_destino_x_hormiga, Vehicle *Vehiculo)
+// Espera a que el escritor vacíe los buzones y libera todo
+static void Terminar_Escritor(Escritor *escritor)
 {
-    // Imprime la lista Tabú del vehículo para fines de depuración
-    // imprimirLista(*Tabu_Vehiculo);
-    // Obtiene el último índice de la lista Tabú del vehículo
-    int indice_ult = Ultimo_Indice(*Tabu_Vehiculo);
-
-    // Crea un objeto Customer 'Origen' con la información del cliente correspondiente al último índice en la lista Tabú del vehículo
-    Customer Origen;
-    Origen.Cliente = Destinos[indice_ult].Cliente;
-    Origen.Demanda = Destinos[indice_ult].Demanda;
-    Origen.Fecha_Vencimiento = Destinos[indice_ult].Fecha_Vencimiento;
-    Origen.Tiempo_Inicio = Destinos[indice_ult].Tiempo_Inicio;
-    Origen.Tiempo_Servicio = Destinos[indice_ult].Tiempo_Servicio;
-    Origen.xCoord = Destinos[indice_ult].xCoord;
-    Origen.yCoord = Destinos[indice_ult].yCoord;
-
-    // Imprime información del cliente Origen
-    // printf("Origen: %d\n", Origen.Cliente);
-    // printf("Demanda: %d\n", Origen.Demanda);
-    // printf("Fecha de vencimiento: %lf\n", Origen.Fecha_Vencimiento);
-    // printf("Tiempo de inicio: %lf\n", Origen.Tiempo_Inicio);
-    // printf("Tiempo de servicio: %lf\n", Origen.Tiempo_Servicio);
-    // printf("Coordenadas: (%lf, %lf)\n", Origen.xCoord, Origen.yCoord);
-
-    // Inicializa un arreglo de clientes 'Destinos_Posibles' para almacenar los destinos que aún no han sido seleccionados
-    int Numero_DestinosPosibles = 1;
-    Customer *Destinos_Posibles = malloc(Numero_DestinosPosibles * sizeof(Customer));
-
-    // Manejo de error en caso de que no se pueda asignar memoria
-    if (Destinos_Posibles == NULL)
-    {
-        fprintf(stderr, "Error al asignar memoria\n");
-    }
-    
-    // Itera sobre todos los clientes para identificar los destinos que aún no han sido seleccionados
-    for (int k = 0; k < MAX_CUSTOMERS; k++)
-    {
-        // Verifica si el índice del cliente no está en la lista Tabú general
-        if (!Validar_Tabu_Indice(*Tabu, k))
-        {
-            double distancia_recorrida = Calcular_Distancia(Origen, Destinos[k]);
-            double tiempo_del_recorrido = Calcular_Tiempo_Recorrido(distancia_recorrida);
-            // printf("Distancia recorrida: %lf\n", distancia_recorrida);
-            // printf("Tiempo del recorrido: %lf\n", tiempo_del_recorrido);
-            // printf("Tiempo calculado del vehiculo: %lf\n", Vehiculo->Tiempo_Consumido + tiempo_del_recorrido);
-            // printf("Vehiculo: %d\n", Vehiculo->number);
-            // printf("Tiempo calculado del destino Inicio: %lf\n", Destinos[k].Tiempo_Inicio);
-            // printf("Tiempo calculado del destino Vencimiento: %lf\n", Destinos[k].Fecha_Vencimiento);
-            // printf("Destino: %d\n", k);
-            //  system("pause");
-            //   printf("Tiempo calculado del vehiculo: %lf\n", Vehiculo->Tiempo_Consumido + tiempo_del_recorrido);
-            //   printf("Vehiculo: %d\n", Vehiculo->number);
-            //   printf("Tiempo calculado del destino Inicio: %lf\n", Destinos[k].Tiempo_Inicio);
-            //   printf("Tiempo calculado del destino Vencimiento: %lf\n", Destinos[k].Fecha_Vencimiento);
-            //    system("pause");
-
-            if (Vehiculo->Tiempo_Consumido + tiempo_del_recorrido >= Destinos[k].Tiempo_Inicio && Vehiculo->Tiempo_Consumido + tiempo_del_recorrido <= Destinos[k].Fecha_Vencimiento)
-            {
-                if (Vehiculo->capacity_restant + Destinos[k].Demanda <= Vehiculo->capacity)
-                {
-                    // printf("Es posible el destino: %d\n", k);
-                    //  Almacena información del destino posible
-                    Destinos_Posibles[Numero_DestinosPosibles - 1].Cliente = Destinos[k].Cliente;
-                    Destinos_Posibles[Numero_DestinosPosibles - 1].Demanda = Destinos[k].Demanda;
-                    Destinos_Posibles[Numero_DestinosPosibles - 1].Fecha_Vencimiento = Destinos[k].Fecha_Vencimiento;
-                    Destinos_Posibles[Numero_DestinosPosibles - 1].Tiempo_Inicio = Destinos[k].Tiempo_Inicio;
-                    Destinos_Posibles[Numero_DestinosPosibles - 1].Tiempo_Servicio = Destinos[k].Tiempo_Servicio;
-                    Destinos_Posibles[Numero_DestinosPosibles - 1].xCoord = Destinos[k].xCoord;
-                    Destinos_Posibles[Numero_DestinosPosibles - 1].yCoord = Destinos[k].yCoord;
-
-                    Numero_DestinosPosibles++;
-                    // Reasigna memoria para almacenar más destinos posibles
-                    Destinos_Posibles = realloc(Destinos_Posibles, Numero_DestinosPosibles * sizeof(Customer));
-                    // Manejo de error en caso de que no se pueda asignar memoria
-                    if (Destinos_Posibles == NULL)
-                    {
-                        fprintf(stderr, "Error al aumentar el tamaño del array de personas\n");
-                    }
-                }
-            }
-
-            /*if (Vehiculo->capacity_restant + Destinos[k].Demanda <= Vehiculo->capacity)
-            {
-
-            }
+    pthread_mutex_lock(&escritor->Candado);
+    escritor->Terminar = true;
+    pthread_cond_signal(&escritor->Hay_Trabajo);
+    pthread_mutex_unlock(&escritor->Candado);
+    pthread_join(escritor->Hilo, NULL);
 
-        }
-
-        */
-
-            // printf("Es posible el destino: %d\n", k);
-            //  Almacena información del destino posible
-            /*
-            Destinos_Posibles[Numero_DestinosPosibles - 1].Cliente = Destinos[k].Cliente;
-            Destinos_Posibles[Numero_DestinosPosibles - 1].Demanda = Destinos[k].Demanda;
-            Destinos_Posibles[Numero_DestinosPosibles - 1].Fecha_Vencimiento = Destinos[k].Fecha_Vencimiento;
-            Destinos_Posibles[Numero_DestinosPosibles - 1].Tiempo_Inicio = Destinos[k].Tiempo_Inicio;
-            Destinos_Posibles[Numero_DestinosPosibles - 1].Tiempo_Servicio = Destinos[k].Tiempo_Servicio;
-            Destinos_Posibles[Numero_DestinosPosibles - 1].xCoord = Destinos[k].xCoord;
-            Destinos_Posibles[Numero_DestinosPosibles - 1].yCoord = Destinos[k].yCoord;
-
-            Numero_DestinosPosibles++;
-            // Reasigna memoria para almacenar más destinos posibles
-            Destinos_Posibles = realloc(Destinos_Posibles, Numero_DestinosPosibles * sizeof(Customer));
-            // Manejo de error en caso de que no se pueda asignar memoria
-            if (Destinos_Posibles == NULL)
-            {
-                fprintf(stderr, "Error al aumentar el tamaño del array de personas\n");
-            }
-            */
-        }
-    }
-    // Ajusta el número total de destinos posibles
-    Numero_DestinosPosibles--;
-
-    if (Numero_DestinosPosibles != 0)
+    if (escritor->Sustituidas > 0)
     {
-        // printf("Numero de Destinos Posibles: %d\n", Numero_DestinosPosibles);
-        // printf("Alpha: %lf\n", Alpha);
-        // printf("Beta: %lf\n\n\n", Beta);
-
-        // Inicializa un arreglo de 'Numeradores' para almacenar los resultados de los cálculos de numerador para cada destino posible
-        double Numeradores[Numero_DestinosPosibles];
-        double Denominador = 0;
-        int cont = 0;
-
-        // Itera sobre todos los destinos posibles para calcular los numeradores y el denominador
-        for (int i = 0; i < Numero_DestinosPosibles; i++)
-        {
-            Numeradores[cont] = Calcular_Numerador(Origen, Destinos_Posibles[i], Alpha, Beta, Gamma);
-            Denominador = Denominador + Numeradores[cont];
-            cont++;
-        }
-
-        // printf("Denominador: %lf\n\n\n", Denominador);
-
-        // Calcula las probabilidades acumuladas utilizando los numeradores y el denominador
-        double *Probabilidades = Probabilidad(Numeradores, Numero_DestinosPosibles, Denominador);
-
-        // Selecciona un destino basado en las probabilidades acumuladas y genera un número aleatorio para tomar una decisión
-        int Posicion_Probabilidades_Elegida = Seleccion_Parte(Probabilidades, Numero_DestinosPosibles);
-
-        // printf("Lista global\n");
-        insertarAlFinal(Tabu, Destinos_Posibles[Posicion_Probabilidades_Elegida].Cliente);
-        // imprimirLista(*Tabu);
-
-        // printf("Lista vehiculo\n");
-        insertarAlFinal(Tabu_Vehiculo, Destinos_Posibles[Posicion_Probabilidades_Elegida].Cliente);
-        // imprimirLista(*Tabu_Vehiculo);
-
-        double distancia_recorrida = Calcular_Distancia(Origen, Destinos_Posibles[Posicion_Probabilidades_Elegida]);
-        double tiempo_del_recorrido = Calcular_Tiempo_Recorrido(distancia_recorrida);
-        Vehiculo->Tiempo_Consumido = Vehiculo->Tiempo_Consumido + Destinos_Posibles[Posicion_Probabilidades_Elegida].Tiempo_Servicio + tiempo_del_recorrido;
-        Vehiculo->capacity_restant = Vehiculo->capacity_restant + Destinos[Posicion_Probabilidades_Elegida].Demanda;
-        // system("pause");
-        free(Destinos_Posibles);
-        free(Probabilidades);
-        return true;
+        printf("%d salidas intermedias se sustituyeron por una mas reciente antes de escribirse.\n", escritor->Sustituidas);
     }
-    else
+#ifdef ESTADISTICAS
+    if (escritor->Renglones_Perdidos > 0)
     {
-        free(Destinos_Posibles);
-        return false;
+        printf("%d renglones de la traza se perdieron por falta de memoria.\n", escritor->Renglones_Perdidos);
     }
+    free(escritor->Traza_Pendiente);
+    free(escritor->Traza_Escribiendo);
+#endif
+    pthread_mutex_destroy(&escritor->Candado);
+    pthread_cond_destroy(&escritor->Hay_Trabajo);
+    Liberar_Matriz(escritor->Feromonas_Pendientes);
+    Liberar_Matriz(escritor->Feromonas_Escribiendo);
+    Liberar_Resultado(&escritor->Ruta_Pendiente);
+    Liberar_Resultado(&escritor->Ruta_Escribiendo);
 }
 
-// Función para la impresion de los vehiculos
-void Imprimir_Vehiculos(Vehicle *Vehiculos, int Numero_Vehiculos)
+// Se llama al final de cada iteración en el hilo de la colonia: deja en los buzones del escritor la mejor ruta hasta el momento y,
+// cada Instantanea_Cada iteraciones y en la última, la matriz de feromonas; con -DESTADISTICAS también el renglón de la traza.
+// Solo copia memoria, no toca el disco
+void Reportar_Iteracion(int Iteracion, const Resultado_Colonia *Mejor, const Feromonas_Colonia *feromonas, void *Datos)
 {
-    // Imprimir información de los vehículos
-    for (int i = 0; i < Numero_Vehiculos; i++)
-    {
-        printf(" * Vehiculo: %d - Capacidad: %d - Tiempo Consumido: %lf - Tiempo Maximo: %lf\n", Vehiculos[i].number, Vehiculos[i].capacity, Vehiculos[i].Tiempo_Consumido, Vehiculos[i].Tiempo_Maximo);
-    }
-}
+    Escritor *escritor = Datos;
 
-// Función para la impresion de los clientes
-void Imprimir_Informacion_Clientes(Customer *clientes)
-{
-    // Imprimir información de los clientes
-    for (int i = 0; i < MAX_CUSTOMERS; i++)
-    {
-        printf("Cliente: %d, Coordenadas: (%lf, %lf), Demanda: %d, Tiempo de inicio: %lf, Fecha de vencimiento: %lf, Tiempo de servicio: %lf\n",
-        clientes[i].Cliente, clientes[i].xCoord, clientes[i].yCoord,
-        clientes[i].Demanda, clientes[i].Tiempo_Inicio,
-        clientes[i].Fecha_Vencimiento, clientes[i].Tiempo_Servicio);
-    }
-}
+    bool Ultima = Iteracion == escritor->Configuracion->Numero_Iteraciones - 1;
+    bool Guardar = Ultima || (escritor->Instantanea_Cada > 0 && (Iteracion + 1) % escritor->Instantanea_Cada == 0);
 
-/*
-// Función para calcular la distancia total recorrida al seguir la lista Tabu de clientes.
-double Recorrer_Tabu_Distancia(struct Nodo *cabeza, Customer *Clientes)
-{
-    double Distancia = 0.0;        // Variable para almacenar la distancia total recorrida
-    double Distancia_Actual = 0.0; // Variable para almacenar la distancia entre dos clientes consecutivos
-    // Imprime información de control
-    // printf("\nIndices Tabu: \n");
-    // Itera sobre la lista Tabu
-    while (cabeza != NULL)
+    pthread_mutex_lock(&escritor->Candado);
+    if (Guardar)
     {
-        if (cabeza->siguiente == NULL)
-        {
-            break;
-        }
-        // Imprime información de los clientes consecutivos en la lista Tabu
-        //printf(" %d - %d       Origen: %d        Destino: %d\n", cabeza->dato, cabeza->siguiente->dato, Clientes[cabeza->dato].Cliente, Clientes[cabeza->siguiente->dato].Cliente);
-
-        // Calcula la distancia entre dos clientes consecutivos
-        Distancia_Actual = Calcular_Distancia(Clientes[cabeza->dato], Clientes[cabeza->siguiente->dato]);
-        //printf("Distancia entre estos puntos: %lf\n", Distancia_Actual);
-
-        //  Suma la distancia actual a la distancia total
-        Distancia = Distancia + Distancia_Actual;
-        //printf("Distancia global del Tabu: %lf\n", Distancia);
-        //  Avanza al siguiente nodo en la lista Tabu
-        cabeza = cabeza->siguiente;
- 
+        escritor->Sustituidas += escritor->Hay_Feromonas;
+        Copiar_Feromonas(feromonas, escritor->Feromonas_Pendientes);
+        escritor->Iteracion_Feromonas = Iteracion;
+        escritor->Hay_Feromonas = true;
     }
-    // Devuelve la distancia total recorrida
-    return Distancia;
-}
-
-// Función para actualizar la matriz de feromonas según la lista Tabu.
-void Actualizar_Feromonas(double Delta, double Rho, struct Nodo *cabeza)
-{
-    // Recorrer la matriz de feromonas
-    for (int i = 0; i < MAX_CUSTOMERS; i++)
+    escritor->Sustituidas += escritor->Hay_Ruta;
+    escritor->Hay_Ruta = Copiar_Resultado(&escritor->Ruta_Pendiente, Mejor);
+#ifdef ESTADISTICAS
+    // El renglón de la traza se copia al buzón, el arreglo crece al doble si el escritor va atrasado
+    if (escritor->Traza != NULL)
     {
-        for (int j = 0; j < MAX_CUSTOMERS; j++)
+        if (escritor->Renglones_Pendientes == escritor->Capacidad_Pendiente)
         {
-            if (i != j)
+            int Capacidad = escritor->Capacidad_Pendiente > 0 ? 2 * escritor->Capacidad_Pendiente : 64;
+            Renglon_Traza *Renglones = realloc(escritor->Traza_Pendiente, Capacidad * sizeof(Renglon_Traza));
+            if (Renglones != NULL)
             {
-                // Evapora las feromonas existentes según el factor Rho
-                feromonas[i][j] = feromonas[i][j] * (1 - Rho);
-            }
-            else
-            {
-                feromonas[i][j] = 0.0; // La diagonal debe ser cero
+                escritor->Traza_Pendiente = Renglones;
+                escritor->Capacidad_Pendiente = Capacidad;
             }
         }
-    }
-    // Itera sobre la lista Tabu
-    while (cabeza != NULL)
-    {
-        if (cabeza->siguiente == NULL)
+        if (escritor->Renglones_Pendientes < escritor->Capacidad_Pendiente)
         {
-            break;
+            escritor->Traza_Pendiente[escritor->Renglones_Pendientes++] =
+                (Renglon_Traza){Iteracion, Mejor->Mejor_Distancia, Mejor->Numero_Rutas, Mejor->Pasos_Construccion, Mejor->Estadisticas};
+        }
+        else
+        {
+            escritor->Renglones_Perdidos++;
         }
-        // Imprime información de los clientes consecutivos en la lista Tabu
-        //printf(" %d - %d\n", cabeza->dato, cabeza->siguiente->dato);
-        // Actualiza las feromonas entre clientes consecutivos en la lista Tabu
-        feromonas[cabeza->dato][cabeza->siguiente->dato] = feromonas[cabeza->dato][cabeza->siguiente->dato] + Delta;
-
-        feromonas[cabeza->siguiente->dato][cabeza->dato] = feromonas[cabeza->siguiente->dato][cabeza->dato] + Delta;
-        // feromonas[cabeza->dato][cabeza->siguiente->dato] = feromonas[cabeza->dato][cabeza->siguiente->dato] * (1-Rho) + Delta;
-        //  Avanza al siguiente nodo en la lista Tabu
-        cabeza = cabeza->siguiente;
-    }
-
-    feromonas[0][0] = 0;
-}*/
-
-// Función para calcular la distancia total recorrida al seguir la lista Tabu de clientes.
-double Recorrer_Tabu_Distancia(struct Nodo *cabeza, Customer *Clientes)
-{
-    if (cabeza == NULL || cabeza->siguiente == NULL) {
-        return 0.0; // Manejar el caso de lista vacía o un solo elemento
-    }
-
-    double Distancia = 0.0;
-    double Distancia_Actual = 0.0;
-    
-    while (cabeza != NULL && cabeza->siguiente != NULL)
-    {
-        Distancia_Actual = Calcular_Distancia(Clientes[cabeza->dato], Clientes[cabeza->siguiente->dato]);
-        Distancia += Distancia_Actual;
-        cabeza = cabeza->siguiente;
     }
-    
-    return Distancia;
+#endif
+    pthread_cond_signal(&escritor->Hay_Trabajo);
+    pthread_mutex_unlock(&escritor->Candado);
 }
 
-
-
-// Función para actualizar la matriz de feromonas según la lista Tabu.
-void Actualizar_Feromonas(double Delta, double Rho, struct Nodo *cabeza)
+// Imprime la brecha de la colonia contra la mejor solución conocida de la instancia, si no hay .sol no imprime nada
+static void Comparar_Con_Solucion(const char *Ruta_Instancia, const Instancia *instancia, const Resultado_Colonia *Resultado)
 {
-  for (int i = 0; i < MAX_CUSTOMERS; i++)
+    Resultado_Colonia Solucion;
+    if (!Buscar_Solucion_Conocida(Ruta_Instancia, instancia, &Solucion))
     {
-        for (int j = 0; j < MAX_CUSTOMERS; j++)
-        {
-            if (i != j)
-            {
-                // Evapora las feromonas existentes según el factor Rho
-                feromonas[i][j] = feromonas[i][j] * (1 - Rho);
-            }
-            else
-            {
-                feromonas[i][j] = 0.0; // La diagonal debe ser cero
-            }
-        }
-    }
-    if (cabeza == NULL || cabeza->siguiente == NULL) {
-        return; // No hay elementos suficientes para actualizar
+        return;
     }
-    
-    while (cabeza != NULL && cabeza->siguiente != NULL)
+    printf("Mejor solucion conocida: %.2f con %d rutas\n", Solucion.Mejor_Distancia, Solucion.Numero_Rutas);
+    if (isfinite(Resultado->Mejor_Distancia))
     {
-        feromonas[cabeza->dato][cabeza->siguiente->dato] += Delta;
-        //feromonas[cabeza->siguiente->dato][cabeza->dato] += Delta;
-        cabeza = cabeza->siguiente;
+        printf("Brecha de la colonia: %.2f%% con %d rutas\n",
+               100.0 * (Resultado->Mejor_Distancia - Solucion.Mejor_Distancia) / Solucion.Mejor_Distancia, Resultado->Numero_Rutas);
     }
-    feromonas[0][0] = 0.0;
-}
-
-
-// Función copia los elementos de una lista enlazada a otra nueva lista.
-void copiarLista(struct Nodo *origen, struct Nodo **destino)
-{
-    // Itera sobre la lista original
-    while (origen != NULL)
+    else
     {
-        // Inserta el elemento actual al final de la nueva lista
-        insertarAlFinal(destino, origen->dato);
-        // Avanza al siguiente elemento en la lista original
-        origen = origen->siguiente;
+        printf("La colonia no encontro una solucion completa\n");
     }
+    Liberar_Resultado(&Solucion);
 }
 
-// Función para agregar un elemento a la lista
-void agregarElemento(struct Nodo **cabeza, int dato)
-{
-    struct Nodo *nuevoNodo = (struct Nodo *)malloc(sizeof(struct Nodo));
-    nuevoNodo->dato = dato;
-    nuevoNodo->siguiente = *cabeza;
-    *cabeza = nuevoNodo;
-}
+#ifdef ESTADISTICAS
+// Nombres de las estrategias de feromonas, en el orden de ESTRATEGIA_AS, ESTRATEGIA_MMAS y ESTRATEGIA_ACS
+static const char *const Nombres_Estrategia[] = {"as", "mmas", "acs"};
 
-// Función para copiar una lista a otra
-void copiarListas(struct Nodo *origen, struct Nodo **destino)
+// Guarda los tiempos por fase y los contadores de la ejecución en JSON
+static void Guardar_Estadisticas(const char *Ruta, const Instancia *instancia, const Configuracion_Colonia *Configuracion,
+                                 const Resultado_Colonia *Resultado, const Escritor *escritor, double Tiempo_Total, long long Bytes_Escritos)
 {
-    while (origen != NULL)
-    {
-        agregarElemento(destino, origen->dato);
-        origen = origen->siguiente;
-    }
-}
-
-char *Ruta_Archivo(int Tipo_Iteracion, int Numero_Iteracion)
-{
-    char *Ruta_Archivo;
-    char *CSV;
-    char *ArchivoInstancia;
-
-    // Tipo de Vector para actualizar en este momento CVS
-    // 1 = Vector Objetivo = V_Objetivo.csv
-    // 2 = Vector Ruido = V_Ruido.csv
-    // 3 = Vector Prueba = V_Prueba.csv
-    if (Tipo_Iteracion == 1)
+    FILE *archivo = fopen(Ruta, "w");
+    if (archivo == NULL)
     {
-        CSV = "Vectores/V_Objetivo";
+        printf("Error al crear el archivo %s.\n", Ruta);
+        return;
     }
-    else if (Tipo_Iteracion == 2)
+    const Estadisticas_Colonia *e = &Resultado->Estadisticas;
+    fprintf(archivo, "{\n");
+    fprintf(archivo, "  \"instancia\": \"%s\",\n  \"clientes\": %d,\n", instancia->nombre, instancia->Numero_Clientes);
+    fprintf(archivo, "  \"parametros\": {\"alpha\": %g, \"beta\": %g, \"gamma\": %g, \"rho\": %g, \"iteraciones\": %d, \"hormigas\": %d, \"semilla\": %u, "
+                     "\"estrategia\": \"%s\", \"q0\": %g, \"xi\": %g, \"reinicio\": %d},\n",
+            Configuracion->Alpha, Configuracion->Beta, Configuracion->Gamma, Configuracion->Rho, Configuracion->Numero_Iteraciones,
+            Configuracion->Numero_Hormigas, Configuracion->Semilla, Nombres_Estrategia[Configuracion->Estrategia], Configuracion->Q0,
+            Configuracion->Xi, Configuracion->Reinicio_Estancamiento);
+    if (isfinite(Resultado->Mejor_Distancia))
     {
-        CSV = "Vectores/V_Ruido";
+        fprintf(archivo, "  \"mejor_distancia\": %f,\n", Resultado->Mejor_Distancia);
     }
-    else if (Tipo_Iteracion == 3)
+    else
     {
-        CSV = "Vectores/V_Prueba";
-    }
-
-    char Num_Ite[10];
-    sprintf(Num_Ite, "%d", Numero_Iteracion);
-
-    size_t Ruta = strlen(CSV) + strlen("/") + strlen(Num_Ite) + strlen(".csv") + 1;
-    Ruta_Archivo = malloc(Ruta);
-    // strcpy(Ruta_Archivo_1, "/");
-    strcpy(Ruta_Archivo, CSV);
-    strcat(Ruta_Archivo, "/");
-    strcat(Ruta_Archivo, Num_Ite);
-    strcat(Ruta_Archivo, ".csv");
-    printf("Ruta Archivo: %s\n", Ruta_Archivo);
-    
-    return Ruta_Archivo;
-}
-
-
-// Función para manejar la señal SIGSEGV
-void manejador_segfault(int sig) {
-    fprintf(stderr, "Error: Violacion de segmento. El programa se detuvo inesperadamente.\n");
-    printf("Hola");
-    FILE *archivo_m;
-    archivo_m = fopen("FuncionObjetivo/FO.txt", "w");
-
-    
-
-    // Escribe el valor en el archivo
-    fprintf(archivo_m, "Error: Violacion de segmento. El programa se detuvo inesperadamente.");
-
-    // Cierra el archivo
-    fclose(archivo_m);
-
-    // Realizar cualquier acción necesaria, como registrar el error en un archivo de registro
-    exit(1); // Salir del programa con un código de error
+        fprintf(archivo, "  \"mejor_distancia\": null,\n");
+    }
+    fprintf(archivo, "  \"rutas\": %d,\n  \"iteraciones\": %d,\n", Resultado->Numero_Rutas, e->Iteraciones);
+    fprintf(archivo, "  \"tiempos_s\": {\"total\": %f, \"preparacion\": %f, \"construccion\": %f, \"distancia\": %f, \"seleccion\": %f, "
+                     "\"feromonas\": %f, \"atractivo\": %f, \"observador\": %f, \"busqueda_local\": %f, "
+                     "\"escritura\": %f},\n",
+            Tiempo_Total, e->Tiempo_Preparacion, e->Tiempo_Construccion, e->Tiempo_Distancia, e->Tiempo_Seleccion, e->Tiempo_Feromonas,
+            e->Tiempo_Atractivo, e->Tiempo_Observador, e->Tiempo_Busqueda_Local, escritor->Tiempo_Escritura);
+    fprintf(archivo, "  \"contadores\": {\"pasos\": %lld, \"candidatos_revisados\": %lld, \"candidatos_factibles\": %lld, "
+                     "\"revisiones_completas\": %lld, \"rutas_abiertas\": %lld, \"hormigas_incompletas\": %lld, "
+                     "\"depositos\": %lld, \"movimientos_evaluados\": %lld, \"movimientos_aplicados\": %lld, \"reinicios\": %lld, "
+                     "\"salidas_sustituidas\": %d, \"bytes_escritos\": %lld},\n",
+            Resultado->Pasos_Construccion, e->Candidatos_Revisados, e->Candidatos_Factibles, e->Revisiones_Completas, e->Rutas_Abiertas,
+            e->Hormigas_Incompletas, e->Depositos, e->Movimientos_Evaluados, e->Movimientos_Aplicados, e->Reinicios,
+            escritor->Sustituidas, Bytes_Escritos);
+    fprintf(archivo, "  \"memoria_maxima_kb\": %ld\n}\n", memoria_maxima_kb());
+    fclose(archivo);
+    printf("Estadisticas guardadas en %s\n", Ruta);
 }
+#endif
 
-
-// Genera una lista global para las rutas de todos los vehiculos
-struct Nodo *Tabu = NULL;
 int main(int argc, char *argv[])
 {
     clock_t inicio, fin;
@@ -962,376 +548,119 @@ int main(int argc, char *argv[])
 
     // Registra el tiempo de inicio
     inicio = clock();
+#ifdef ESTADISTICAS
+    double Inicio_Total = Tiempo_Monotonico();
+#endif
 
     double tiempo_transcurrido;
 
-    const char *nombreArchivo = "C101.csv";
+    // Instancia por defecto, se puede cambiar con el noveno argumento
+    const char *nombreArchivo = "Instancias/Csv/C101.csv";
 
-    // IMPORTANTE Verifica si se proporcionaron suficientes argumentos en la línea de comandos
-    if (argc < 7)
+    // Las opciones de la estrategia de feromonas (--estrategia=, --q0=, --xi=, --reinicio=) pueden ir en cualquier lugar
+    Configuracion_Colonia Configuracion;
+    Configurar_Estrategia(&Configuracion, ESTRATEGIA_AS);
+    argc = Separar_Opciones_Colonia(argc, argv, &Configuracion);
+    if (argc < 0)
     {
-        printf("Uso: %s <num_iteraciones> <num_hormigas> <alpha> <beta> <gamma> <rho> \n", argv[0]); // gamma es la importancia de el ultimo tiempo para visitar al cliente
         return 1;
     }
 
+    // IMPORTANTE Verifica si se proporcionaron suficientes argumentos en la línea de comandos
+    if (argc < 9)
+    {
+        printf("Uso: %s <num_iteraciones> <num_hormigas> <alpha> <beta> <gamma> <rho> <tipo_vector> <n_iteracion> [instancia.txt|csv] [feromonas_cada] [traza.csv] [--estrategia=as|mmas|acs] [--q0=<p>] [--xi=<x>] [--reinicio=<iteraciones>]\n", argv[0]); // gamma es la importancia de el ultimo tiempo para visitar al cliente
+        return 1;
+    }
 
     // Obtener parámetros desde la línea de comandos
-    int num_iteraciones = atoi(argv[1]);
-    int num_hormigas = atoi(argv[2]);
-    Alpha = atof(argv[3]);
-    Beta = atof(argv[4]);
-    Gamma = atof(argv[5]); // este es el que añadi
-    Rho = atof(argv[6]);
+    Configuracion.Numero_Iteraciones = atoi(argv[1]);
+    Configuracion.Numero_Hormigas = atoi(argv[2]);
+    Configuracion.Alpha = atof(argv[3]);
+    Configuracion.Beta = atof(argv[4]);
+    Configuracion.Gamma = atof(argv[5]);
+    Configuracion.Rho = atof(argv[6]);
+    Configuracion.Semilla = obtener_semilla_aleatoria();
+    Configuracion.Numero_Hilos = 0;
+    Configuracion.Hormigas_Busqueda_Local = HORMIGAS_BUSQUEDA_LOCAL;
     int Tipo_Vector = atoi(argv[7]);
     int N_Iteracion = atoi(argv[8]);
-
-    // Ruta del archivo a guardar dependiendo del tipo de vector y la iteración actual la mejor ruta
-    char *Route_Archive = Ruta_Archivo(Tipo_Vector, N_Iteracion);
-
-    int numeroDeLineas = 102; // Asumiendo un valor para la demostración del archivo C101.csv
-
-    // Imprime información de la instancia y parámetros
-    printf("El archivo %s tiene %d lineas.\n", nombreArchivo, numeroDeLineas);
-    // system("pause"); // LOGS
-
-    // Abrir el archivo de entrada
-    FILE *archivo;
-    archivo = fopen("Instancias/Csv/C101.csv", "r");
-    // Manejo de errores si no se pudo abrir el archivo
-    if (archivo == NULL)
+    if (argc > 9)
     {
-
-        fprintf(stderr, "No se pudo abrir el archivo\n");
-        return 1;
+        nombreArchivo = argv[9];
     }
-
-    // Leer información de la instancia desde el archivo
-    char nombre_instancia[50];
-    int Numero_Vehiculos;
-    int Capacidad;
-
-    fscanf(archivo, "%s", nombre_instancia);
-    fscanf(archivo, "%d,%d", &Numero_Vehiculos, &Capacidad);
-
-    // Imprime información de la instancia y parámetros
-    printf("Nombre de la instancia: %s\n", nombre_instancia);
-    printf("Numero de Vehiculos: %d\n", Numero_Vehiculos);
-    printf("Capacidad de c/Vehiculo: %d\n", Capacidad);
-
-    // Inicializa la información de los vehículos
-    Vehicle Vehiculos[Numero_Vehiculos];
-
-    for (int i = 0; i < Numero_Vehiculos; i++)
+    // Cada cuántas iteraciones se guarda la matriz de feromonas, por defecto solo al final
+    int Instantanea_Cada = argc > 10 ? atoi(argv[10]) : 0;
+    // Traza opcional con los tiempos y contadores acumulados en cada iteración
+    const char *Ruta_Traza = argc > 11 ? argv[11] : NULL;
+#ifndef ESTADISTICAS
+    if (Ruta_Traza != NULL)
     {
-        Vehiculos[i].number = i + 1;
-        Vehiculos[i].capacity = Capacidad;
+        printf("La traza por iteracion necesita compilar con -DESTADISTICAS, se ignora %s\n", Ruta_Traza);
     }
+#endif
 
-    // Leer información de clientes desde el archivo
-    Customer clientes[MAX_CUSTOMERS];
+    // Ruta del archivo a guardar dependiendo del tipo de vector y la iteración actual la mejor ruta
+    char *Route_Archive = Ruta_Archivo(Tipo_Vector, N_Iteracion);
+    printf("Ruta Archivo: %s\n", Route_Archive);
 
-    for (int i = 0; i < MAX_CUSTOMERS; i++)
+    // Leer información de la instancia desde el archivo
+    Instancia *instancia = Cargar_Instancia(nombreArchivo);
+    if (instancia == NULL)
     {
-        fscanf(archivo, "%d,%lf,%lf,%d,%lf,%lf,%lf",
-               &clientes[i].Cliente, &clientes[i].xCoord, &clientes[i].yCoord,
-               &clientes[i].Demanda, &clientes[i].Tiempo_Inicio,
-               &clientes[i].Fecha_Vencimiento, &clientes[i].Tiempo_Servicio);
+        free(Route_Archive);
+        return 1;
     }
 
-    // Cerrar el archivo después de la lectura
-    fclose(archivo);
+    // Imprime información de la instancia y parámetros
+    printf("Nombre de la instancia: %s\n", instancia->nombre);
+    printf("Numero de Vehiculos: %d\n", instancia->Numero_Vehiculos);
+    printf("Capacidad de c/Vehiculo: %d\n", instancia->Capacidad);
+    printf("Numero de Clientes: %d\n", instancia->Numero_Clientes);
 
-    // Imprimir información de los clientes
-    //Imprimir_Informacion_Clientes(clientes);
-    //system("pause"); // LOGS
+    Guardar_Visibilidad(instancia, &Configuracion);
 
-    for (int i = 0; i < Numero_Vehiculos; i++)
+    Escritor escritor;
+    if (!Iniciar_Escritor(&escritor, instancia, &Configuracion, Route_Archive, Instantanea_Cada))
     {
-        Vehiculos[i].Tiempo_Consumido = clientes[0].Tiempo_Inicio;  // Tiempo de inicio permitido en relacion al deposito que es Cliente [0] = 0
-        Vehiculos[i].Tiempo_Maximo = clientes[0].Fecha_Vencimiento; // Fecha de vencimiento en relacion al deposito que es Cliente [0] = 1236
+        fprintf(stderr, "No se pudo iniciar el hilo escritor\n");
+        Liberar_Instancia(instancia);
+        free(Route_Archive);
+        return 1;
     }
-
-    //Imprimir_Vehiculos(Vehiculos, Numero_Vehiculos);
-
-    // system("pause"); // LOGS
-
-    // Inicializar feromonas y visibilidad
-    inicializar_feromonas(MAX_CUSTOMERS);
-
-    Guardar_Feromonas();
-    // system("pause"); // LOGS
-
-    inicializar_visibilidad(MAX_CUSTOMERS, clientes);
-
-    Guardar_Visibilidad();
-    // system("pause"); // LOGS
-
-    double Mejor_Distancia = INFINITY;     // Inicializado a infinito para asegurar que cualquier distancia sea mejor
-    struct Nodo *Mejor_Ruta[num_hormigas]; // Lista para almacenar la mejor ruta
-    struct Nodo *listaCombinada = NULL;    // Lista para almacenar la mejor ruta de todas las hormigas combinadas en una sola lista para calcular la feromona
-    // struct Nodo *Tabu_Vehiculo[num_hormigas];
-
-    //  Bucle principal que ejecuta el Algoritmo de Colonia de Hormigas durante un número especificado de iteraciones.
-    srand(obtener_semilla_aleatoria());
-    for (int x = 0; x < num_iteraciones; x++)
+#ifdef ESTADISTICAS
+    if (Ruta_Traza != NULL)
     {
-        //printf("Iteracion: %d\n", x);
-
-        // Inicialización de cada vehículo con el tiempo de inicio permitido, la fecha de vencimiento y la capacidad restante del vehículo en relación con el depósito (Cliente [0])
-        for (int i = 0; i < Numero_Vehiculos; i++)
+        escritor.Traza = fopen(Ruta_Traza, "w");
+        if (escritor.Traza == NULL)
         {
-            Vehiculos[i].Tiempo_Consumido = clientes[0].Tiempo_Inicio;
-            Vehiculos[i].Tiempo_Maximo = clientes[0].Fecha_Vencimiento;
-            Vehiculos[i].capacity_restant = 0;
+            printf("Error al crear el archivo %s.\n", Ruta_Traza);
         }
-
-        // Imprimir_Vehiculos(Vehiculos, Numero_Vehiculos);
-        // system("pause"); // LOGS
-
-        // Inicialización de Tabu_Vehiculo para cada hormiga
-        struct Nodo *Tabu_Vehiculo[num_hormigas];
-
-
-        /*for (int i = 0; i < num_hormigas; i++)
-        {
-            Tabu_Vehiculo[i] = NULL;
-        }*/
-
-        // Asignación de memoria y configuración inicial de Tabu_Vehiculo
-        for (int i = 0; i < num_hormigas; i++)
-        {
-
-            Tabu_Vehiculo[i] = (struct Nodo *)malloc(sizeof(struct Nodo));
-            Tabu_Vehiculo[i] = NULL;
-            insertarAlFinal(&Tabu_Vehiculo[i], 0);
-            
-        }
-        
-
-        /*for (int i = 0; i < num_hormigas; i++)
-        {
-            insertarAlFinal(&Tabu_Vehiculo[i], 0);
-        }
-        */
-
-        // Inicialización de Tabu con un depósito
-        insertarAlFinal(&Tabu, 0);
-        
-
-        // printf("Lista de Hormigas\n");
-        //  Impresión de las listas Tabu_Vehiculo iniciales para cada hormiga
-
-        /*for (int i = 0; i < num_hormigas; i++)
-        {
-            printf("Hormiga %d ", i);
-            imprimirLista(Tabu_Vehiculo[i]);
-        }*/
-
-        // system("pause"); // LOGS
-
-        // printf("Lista Tabu General\n");
-        // imprimirLista(Tabu);
-        // system("pause"); // LOGS
-
-        // Bool para verificar si se superó el número máximo de intentos
-        bool Prueba = false;
-         int comparacion = 0;
-        for (int i = 0; i < MAX_CUSTOMERS - 1; i++)
-        {
-            int Numero_Intentos = 0;
-            // Bool para verificar si se asignó un cliente a un vehículo
-            bool Se_Asigno = false;
-            do
-            {
-                // printf("Iteracion: %d\n", i);
-
-                // Generación de un número aleatorio para seleccionar una hormiga
-                //srand(obtener_semilla_aleatoria());
-                sleep(0.01);
-                
-                int Hormiga = Generar_Valores(0, 10);
-                //no generar el mismo numero de hormiga en la misma iteracion
-                /*
-                while (comparacion == Hormiga)
-                {
-                    Hormiga = Generar_Valores(0, 10);
-                }
-                comparacion = Hormiga;
-                */
-                
-                
-                // printf("Hormiga seleccionada: %d\n", Hormiga);
-                // system("pause"); // LOGS
-
-
-                //  Cálculo de probabilidades y actualización de la lista Tabu_Vehiculo para la hormiga seleccionada
-                Se_Asigno = Calculo_Probabilidad(clientes, &Tabu, &Tabu_Vehiculo[Hormiga], num_hormigas, MAX_CUSTOMERS / num_hormigas, &Vehiculos[Hormiga]);
-
-                if (Se_Asigno)
-                {
-                    //  Impresión de la lista Tabu_Vehiculo actualizada para la hormiga seleccionada
-                    // printf("Hormiga seleccionada %d ", Hormiga);
-                    // imprimirLista(Tabu_Vehiculo[Hormiga]);
-
-                    // system("pause"); // LOGS
-                }
-
-                //   Incremento del número de intentos
-                Numero_Intentos++;
-                //  Verificación de si se superó el número máximo de intentos
-                if (Numero_Intentos > 100)
-                {
-                    Prueba = true;
-                    // printf("Error: Se superó el número máximo de intentos.\n");
-                    break;
-                }
-
-            } while (!Se_Asigno);
-        }
-
-        // Verificación de si se superó el número máximo de intentos y reinicio del bucle principal si es necesario 
-        if (Prueba)
-        {
-            num_iteraciones++;
-            // Reinicia la lista Tabu para la siguiente iteración
-            free(Tabu);
-            Tabu = NULL;
-            for (int i = 0; i < num_hormigas; i++)
-            {
-                free(Tabu_Vehiculo[i]);
-                Tabu_Vehiculo[i] = NULL;
-            }
-            // free(Tabu_Vehiculo);
-            //  printf("Error: Se superó el número máximo de intentos.\n");
-            continue;
-        }
-
-        // Actualización de Tabu_Vehiculo con un depósito al final
-        for (int i = 0; i < num_hormigas; i++)
-        {
-            insertarAlFinal(&Tabu_Vehiculo[i], 0);
-        }
-
-        // Impresión de las listas Tabu_Vehiculo después de la actualización
-        /*for (int i = 0; i < num_hormigas; i++)
-        {
-            printf("\n\nTabu del Vehiculo %d:", i);
-            imprimirLista(Tabu_Vehiculo[i]);
-        }*/
-        // system("pause"); // LOGS
-
-        // Cálculo de distancias para cada vehículo y acumulación de distancias totales
-        double Distancias_Vehiculos[num_hormigas];
-        double Suma_Distancias_Vehiculos = 0;
-
-        for (int i = 0; i < num_hormigas; i++)
-        {
-            Distancias_Vehiculos[i] = Recorrer_Tabu_Distancia(Tabu_Vehiculo[i], clientes);
-            Suma_Distancias_Vehiculos = Suma_Distancias_Vehiculos + Distancias_Vehiculos[i];
-            // printf("\nVehiculo %d - Distancia global del Vehiculo: %lf", i, Distancias_Vehiculos[i]);
-        }
-
-        // Verificación y actualización de la mejor solución encontrada
-        if (Suma_Distancias_Vehiculos < Mejor_Distancia)
-        {
-            // Actualización de Mejor_Distancia y copia de las mejores rutas encontradas
-            Mejor_Distancia = Suma_Distancias_Vehiculos;
-
-            /*for (int i = 0; i < num_hormigas; ++i)
-            {
-                Mejor_Ruta[i] = NULL;
-            }*/
-            for (int i = 0; i < num_hormigas; i++)
-            {
-                Mejor_Ruta[i] = (struct Nodo *)malloc(sizeof(struct Nodo));
-                Mejor_Ruta[i] = NULL;
-                copiarLista(Tabu_Vehiculo[i], &Mejor_Ruta[i]);
-            }
-        }
-
-        // Imprime la suma total de las distancias recorridas por todos los vehículos
-        //printf("\n\nDistancias Total de los Vehiculos: %lf", Suma_Distancias_Vehiculos);
-
-        // Calcula el valor Delta para actualizar las feromonas
-        double Delta = 1.0 / Suma_Distancias_Vehiculos;
-        // Imprime Delta
-        // printf("\n\nDelta: %lf\n", Delta);
-
-        
-        // printf("lista tabu\n");
-        //imprimirLista(Tabu);
-
-        // Copiar las listas Tabu_Vehiculo de todas las hormigas en una sola lista para calcular la feromona 
-        for (int i = num_hormigas - 1; i >= 0; i--)
-        {
-            copiarLista(Tabu_Vehiculo[i], &listaCombinada);
-        }
-
-        //printf("lista combinada\n");
-        //imprimirLista(listaCombinada);
-
-        //Actualizar_Feromonas(Delta, Rho, Tabu);
-        
-        // Actualiza la matriz de feromonas 
-        Actualizar_Feromonas(Delta, Rho, listaCombinada);
-
-        // Liberar memoria de la lista donde se almacenan las rutas combinadas
-        listaCombinada = NULL;
-
-        Guardar_Feromonas();
-
-        // Reinicia la lista Tabu para la siguiente iteración
-        Tabu = NULL;
-
-
-        // pausa la ejecución para visualización
-        // system("pause");
-        // Impresión de la mejor distancia total y las mejores rutas encontradas hasta el momento
-        printf("\n\nMejor Distancia Total(FO): %lf\n", Mejor_Distancia);
-
-        printf("Mejor Ruta:\n");
-
-        FILE *archivo_c = fopen(Route_Archive, "w");
-        if (archivo_c == NULL)
-        {
-            fprintf(stderr, "Error al abrir el archivo.\n");
-            return 1;
-        }
-        fclose(archivo_c);
-        for (int i = 0; i < num_hormigas; i++)
-        {
-            printf("Hormiga %d: ", i);
-            imprimirLista(Mejor_Ruta[i]);
-            guardarListaCSV(Mejor_Ruta[i], Route_Archive);
-        }
-        // Imprimir_Vehiculos(Vehiculos, Numero_Vehiculos);
-        // system("pause"); // LOGS
-        // Visualizar_Feromonas();
-        //system("pause");
-
-        // Reinicia la lista Tabu para la siguiente iteración
-        free(Tabu);
-        //Tabu = NULL;
-        for (int i = 0; i < num_hormigas; i++)
+        else
         {
-            free(Tabu_Vehiculo[i]);
-            Tabu_Vehiculo[i] = NULL;
+            fprintf(escritor.Traza, "iteracion,mejor_distancia,rutas,pasos,construccion_s,distancia_s,seleccion_s,feromonas_s,atractivo_s,"
+                                    "observador_s,busqueda_local_s,candidatos_revisados,candidatos_factibles,revisiones_completas,"
+                                    "rutas_abiertas,hormigas_incompletas,movimientos_evaluados,movimientos_aplicados,reinicios\n");
         }
-        free(listaCombinada);
-        // free(Tabu_Vehiculo);
-       
-
     }
-    // free(Mejor_Ruta);
+#endif
 
-    // Liberar memoria de la lista donde se almacenan las mejores rutas encontradas
-    for (int i = 0; i < num_hormigas; i++)
+    Resultado_Colonia Resultado;
+    int Estado = Resolver_Colonia(instancia, &Configuracion, &Resultado, Reportar_Iteracion, &escritor);
+    Terminar_Escritor(&escritor);
+#ifdef ESTADISTICAS
+    if (escritor.Traza != NULL)
     {
-        free(Mejor_Ruta[i]);
-        Mejor_Ruta[i] = NULL;
+        fclose(escritor.Traza);
+    }
+#endif
+    if (Estado != 0)
+    {
+        fprintf(stderr, "Parametros de la colonia invalidos\n");
+        Liberar_Instancia(instancia);
+        free(Route_Archive);
+        return 1;
     }
-
-    
 
     FILE *archivo_m;
     archivo_m = fopen("FuncionObjetivo/FO.txt", "w");
@@ -1344,11 +673,23 @@ int main(int argc, char *argv[])
     }
 
     // Escribe el valor en el archivo
-    fprintf(archivo_m, "%f", Mejor_Distancia);
+    fprintf(archivo_m, "%f", Resultado.Mejor_Distancia);
 
     // Cierra el archivo
     fclose(archivo_m);
 
+    Comparar_Con_Solucion(nombreArchivo, instancia, &Resultado);
+
+#ifdef ESTADISTICAS
+    long long Bytes_Escritos = escritor.Bytes_Escritos + Tam_Archivo("MatricesF&V/Matriz_Visibilidad.bin") + Tam_Archivo("FuncionObjetivo/FO.txt");
+    Guardar_Estadisticas("JSON/Estadisticas.json", instancia, &Configuracion, &Resultado, &escritor, Tiempo_Monotonico() - Inicio_Total,
+                         Bytes_Escritos);
+#endif
+
+    Liberar_Resultado(&Resultado);
+    Liberar_Instancia(instancia);
+    free(Route_Archive);
+
     // Registra el tiempo de finalización
     fin = clock();
 
@@ -1356,7 +697,7 @@ int main(int argc, char *argv[])
     tiempo_transcurrido = ((double)(fin - inicio)) / CLOCKS_PER_SEC;
 
     printf("El tiempo de ejecucion fue de %.2f segundos.\n", tiempo_transcurrido);
-    
+    printf("Memoria maxima (RSS): %ld KB\n", memoria_maxima_kb());
 
     return 0;
 }
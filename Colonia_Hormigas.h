@@ -0,0 +1,194 @@
+// Autor: Williams Chan Pescador
+// Algorithm: Colonias de Hormigas para el VRP con ventanas de tiempo
+// Description: Interfaz de la colonia de hormigas como biblioteca reentrante. La instancia se carga una sola vez
+//              y se puede resolver tantas veces como se necesite con distintos parámetros sin lanzar procesos
+#ifndef COLONIA_HORMIGAS_H
+#define COLONIA_HORMIGAS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef struct
+{
+    int Cliente;              // Número identificador del cliente
+    double xCoord;            // Coordenada X del cliente en el plano
+    double yCoord;            // Coordenada Y del cliente en el plano
+    int Demanda;              // Cantidad demandada por el cliente
+    double Tiempo_Inicio;     // Tiempo de inicio permitido para el servicio
+    double Fecha_Vencimiento; // Fecha límite para el servicio
+    double Tiempo_Servicio;   // Tiempo necesario para atender al cliente
+} Customer;
+
+// Los mismos datos de los clientes por columnas (estructura de arreglos), que es como los leen la construcción de soluciones y el
+// cálculo de las matrices: un arreglo de Numero_Clientes valores por campo, cada uno alineado a la línea de cache. La demanda
+// se guarda como double para compararse junto con los tiempos
+typedef struct
+{
+    double *xCoord;
+    double *yCoord;
+    double *Demanda;
+    double *Tiempo_Inicio;
+    double *Fecha_Vencimiento;
+    double *Tiempo_Servicio;
+} Columnas_Clientes;
+
+// Estructura para representar una instancia ya cargada en memoria (solo lectura durante la resolución).
+// Las matrices son de Numero_Clientes x Numero_Clientes, contiguas por renglón: el arco (i, j) está en [i * Numero_Clientes + j]
+typedef struct
+{
+    char nombre[50];            // Nombre de la instancia
+    int Numero_Vehiculos;       // Número de vehículos disponibles
+    int Capacidad;              // Capacidad de c/Vehiculo
+    int Numero_Clientes;        // Número de clientes contando al deposito
+    Customer *clientes;         // Clientes, el cliente 0 es el deposito
+    Columnas_Clientes columnas; // Clientes por columnas, todas en un solo bloque que empieza en columnas.xCoord
+    double *distancias;         // Distancia euclidiana entre clientes
+    double *tiempos;            // Tiempo de recorrido entre clientes
+    double *visibilidad;        // Inversa de la distancia entre clientes
+    int Numero_Candidatos;      // Vecinos en la lista de candidatos de cada cliente
+    int *candidatos;            // Numero_Clientes x Numero_Candidatos, los clientes más cercanos a cada cliente ordenados por distancia
+    double *tiempos_candidatos; // Numero_Clientes x Numero_Candidatos, tiempo de recorrido de cada cliente a cada uno de sus candidatos
+    void *Cache;                // Archivo de cache mapeado (de solo lectura) que contiene las matrices y los candidatos, NULL si están en el heap
+    size_t Tam_Cache;           // Tamaño del mapeo de la cache
+} Instancia;
+
+// Parámetros de una ejecución de la colonia de hormigas
+typedef struct
+{
+    double Alpha;                // Importancia de la feromona
+    double Beta;                 // Importancia de la visibilidad
+    double Gamma;                // Importancia de la fecha de vencimiento del cliente
+    double Rho;                  // Factor de evaporación
+    int Numero_Iteraciones;      // Número de iteraciones de la colonia
+    int Numero_Hormigas;         // Número de hormigas, cada una construye una solución completa
+    unsigned int Semilla;        // Semilla del generador aleatorio de esta ejecución
+    int Numero_Hilos;            // Hilos que construyen las soluciones de las hormigas, 0 = uno por núcleo
+    int Hormigas_Busqueda_Local; // Mejores hormigas de cada iteración que se mejoran con búsqueda local, 0 = sin búsqueda local
+    int Estrategia;              // Regla de feromonas: ESTRATEGIA_AS, ESTRATEGIA_MMAS o ESTRATEGIA_ACS
+    double Q0;                   // ACS: probabilidad de ir al destino con mayor numerador en lugar de usar la ruleta
+    double Xi;                   // ACS: evaporación local de los arcos que usan las hormigas
+    int Reinicio_Estancamiento;  // MMAS: iteraciones sin mejorar la mejor solución tras las que se reinician las feromonas, 0 = nunca
+} Configuracion_Colonia;
+
+// Estrategias de actualización de feromonas
+#define ESTRATEGIA_AS 0   // Ant System: toda la matriz se evapora y todas las hormigas completas depositan
+#define ESTRATEGIA_MMAS 1 // MAX-MIN Ant System: solo deposita la mejor solución, feromonas acotadas y reinicio por estancamiento
+#define ESTRATEGIA_ACS 2  // Ant Colony System: regla pseudoaleatoria proporcional (Q0) y actualización local (Xi)
+
+// Hormigas que mejoran con búsqueda local los programas de este repositorio, se cambia al compilar con -DHORMIGAS_BUSQUEDA_LOCAL=<k>
+#ifndef HORMIGAS_BUSQUEDA_LOCAL
+#define HORMIGAS_BUSQUEDA_LOCAL 1
+#endif
+
+// Tiempos (segundos) y contadores acumulados de una ejecución. Solo se llenan si la biblioteca se compiló con -DESTADISTICAS,
+// sin esa bandera no se mide nada y quedan en cero
+typedef struct
+{
+    int Iteraciones;                 // Iteraciones terminadas
+    double Tiempo_Preparacion;       // Reservar la colonia e inicializar feromonas, heurística y atractivo
+    double Tiempo_Construccion;      // Construir las soluciones de todas las hormigas, incluye evaluar su distancia
+    double Tiempo_Distancia;         // Evaluar la distancia de las soluciones, sumado sobre los hilos
+    double Tiempo_Seleccion;         // Elegir la mejor hormiga de la iteración y exportar su solución
+    double Tiempo_Feromonas;         // Evaporar y sumar los depósitos
+    double Tiempo_Atractivo;         // Recalcular el numerador de cada arco
+    double Tiempo_Observador;        // Observador de cada iteración (la salida del programa)
+    double Tiempo_Busqueda_Local;    // Mejorar las mejores hormigas con búsqueda local
+    long long Candidatos_Revisados;  // Destinos cuya factibilidad se revisó
+    long long Candidatos_Factibles;  // Destinos factibles entre los revisados
+    long long Revisiones_Completas;  // Pasos en que ningún vecino era factible y se revisaron todos los clientes
+    long long Rutas_Abiertas;        // Vehículos que salieron del deposito
+    long long Hormigas_Incompletas;  // Hormigas que no lograron visitar a todos los clientes
+    long long Depositos;             // Arcos con depósito de feromona de todas las hormigas (AS)
+    long long Movimientos_Evaluados; // Movimientos de la búsqueda local cuyo cambio de distancia se calculó
+    long long Movimientos_Aplicados; // Movimientos de la búsqueda local que redujeron la distancia
+    long long Reinicios;             // MMAS: veces que se reiniciaron las feromonas por estancamiento
+} Estadisticas_Colonia;
+
+// Mejor solución encontrada por la colonia
+typedef struct
+{
+    double Mejor_Distancia;       // Distancia total de la mejor solución (FO)
+    int Numero_Rutas;             // Número de rutas de la mejor solución
+    int *Inicio_Ruta;             // Numero_Rutas + 1 desplazamientos dentro de Nodos
+    int *Nodos;                   // Clientes de todas las rutas, cada ruta empieza y termina en el deposito
+    long long Pasos_Construccion; // Clientes elegidos por todas las hormigas hasta el momento, mide el trabajo de la colonia
+    Estadisticas_Colonia Estadisticas; // Tiempos y contadores hasta el momento (con -DESTADISTICAS)
+} Resultado_Colonia;
+
+// Matriz de feromonas con la evaporación pendiente: la feromona del arco i (fuera de la diagonal) es max(Valores[i] * Escala, Minima).
+// Evaporar toda la matriz solo cambia Escala; Copiar_Feromonas escribe los valores efectivos
+typedef struct
+{
+    const double *Valores; // Numero_Clientes * Numero_Clientes valores guardados
+    double Escala;         // Evaporación acumulada desde la última normalización
+    double Minima;         // Límite inferior de MMAS, 0 en las demás estrategias
+    int Numero_Clientes;
+} Feromonas_Colonia;
+
+// Función que se llama al final de cada iteración con la mejor solución hasta el momento y la matriz de feromonas
+typedef void (*Observador_Iteracion)(int Iteracion, const Resultado_Colonia *Mejor, const Feromonas_Colonia *feromonas, void *Datos);
+
+// Carga una instancia de cualquier tamaño y precalcula sus matrices de distancia, tiempo y visibilidad y las listas de candidatos,
+// devuelven NULL si no se pudo leer. Cargar_Instancia elige el formato por la extensión: .txt de Solomon o CSV
+Instancia *Cargar_Instancia(const char *Ruta);
+Instancia *Cargar_Instancia_CSV(const char *Ruta);
+Instancia *Cargar_Instancia_Solomon(const char *Ruta);
+void Liberar_Instancia(Instancia *instancia);
+
+// Reserva y libera las matrices de la colonia: un solo bloque alineado a la línea de cache
+double *Reservar_Matriz(int Numero_Clientes);
+void Liberar_Matriz(double *Matriz);
+
+// Escribe en Destino (Numero_Clientes * Numero_Clientes) las feromonas efectivas, con cero en la diagonal. Destino puede ser Valores
+void Copiar_Feromonas(const Feromonas_Colonia *feromonas, double *Destino);
+
+// Ejecuta la colonia de hormigas sobre la instancia, no usa estado global por lo que es reentrante.
+// Observador puede ser NULL. Devuelve 0 si terminó correctamente
+int Resolver_Colonia(const Instancia *instancia, const Configuracion_Colonia *Configuracion, Resultado_Colonia *Resultado,
+                     Observador_Iteracion Observador, void *Datos);
+void Liberar_Resultado(Resultado_Colonia *Resultado);
+
+// Pone la estrategia de feromonas con sus parámetros por defecto: Q0 = 0.9, Xi = 0.1 y reinicio tras 100 iteraciones sin mejora
+void Configurar_Estrategia(Configuracion_Colonia *Configuracion, int Estrategia);
+// Lee de la línea de comandos las opciones de la estrategia (--estrategia=as|mmas|acs, --q0=<p>, --xi=<x>, --reinicio=<iteraciones>),
+// que pueden ir en cualquier lugar, y deja en argv solo los argumentos posicionales. Devuelve el nuevo argc, -1 si una opción
+// no es válida
+int Separar_Opciones_Colonia(int argc, char *argv[], Configuracion_Colonia *Configuracion);
+
+// Lee la mejor solución conocida de un archivo .sol de Solomon ("Route #k: ..." y "Cost ..."), con las rutas en la misma forma
+// que el resultado de la colonia. Devuelve false si no se pudo leer; se libera con Liberar_Resultado
+bool Cargar_Solucion_Solomon(const char *Ruta, Resultado_Colonia *Solucion);
+
+// Busca la mejor solución conocida de una instancia: el .sol junto a su archivo o el de Solomon con el mismo nombre
+bool Buscar_Solucion_Conocida(const char *Ruta_Instancia, const Instancia *instancia, Resultado_Colonia *Solucion);
+
+// Instantáneas binarias de las matrices de la colonia. El archivo empieza con un encabezado de TAM_ENCABEZADO_MATRIZ bytes,
+// todos los números en little-endian:
+//     0  char[8]   "ACOMATRZ"
+//     8  uint32    versión del formato (1)
+//    12  uint32    tipo de matriz, MATRIZ_FEROMONAS o MATRIZ_VISIBILIDAD
+//    16  uint32    renglones
+//    20  uint32    columnas
+//    24  int32     iteración de la colonia, -1 si la matriz no cambia durante la ejecución
+//    28  uint32    semilla de la ejecución
+//    32  char[48]  nombre de la instancia terminado en 0
+//    80  double    Alpha, Beta, Gamma, Rho
+//   112  int32     número de iteraciones, número de hormigas
+//   120  8 bytes   reservados en 0
+// Después vienen los renglones x columnas valores double por renglón. Con el encabezado de 128 bytes los datos quedan alineados
+// y el archivo se puede mapear a memoria y leer como arreglo. MatricesF&V/Convertir_Matriz_CSV.py lo convierte a CSV
+#define TAM_ENCABEZADO_MATRIZ 128
+#define MATRIZ_FEROMONAS 1
+#define MATRIZ_VISIBILIDAD 2
+
+// Guarda una matriz de Numero_Clientes x Numero_Clientes de la instancia en el formato binario de arriba. Se escribe a un archivo
+// temporal que luego reemplaza a Ruta, así quien tenga el archivo anterior mapeado nunca ve una matriz a medias
+bool Guardar_Matriz_Binaria(const char *Ruta, int Tipo, const double *Matriz, const Instancia *instancia, int Iteracion,
+                            const Configuracion_Colonia *Configuracion);
+
+// Ruta del archivo donde se guarda la mejor ruta dependiendo del tipo de vector y la iteración
+char *Ruta_Archivo(int Tipo_Iteracion, int Numero_Iteracion);
+// Guarda las rutas del resultado en formato CSV, una ruta por renglón
+bool Guardar_Rutas_CSV(const Resultado_Colonia *Resultado, const char *nombreArchivo);
+
+#endif
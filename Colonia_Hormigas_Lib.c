@@ -0,0 +1,3087 @@
+// Autor: Williams Chan Pescador
+// Algorithm: Colonias de Hormigas para el VRP con ventanas de tiempo
+// Description: Implementación reentrante de la colonia de hormigas, todo el estado de una ejecución vive en la estructura Colonia
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <pthread.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "Colonia_Hormigas.h"
+
+// Estructura para representar un vehículo
+typedef struct
+{
+    int number;              // Número identificador del vehículo
+    int capacity;            // Capacidad del vehículo
+    int capacity_restant;    // Capacidad restante del vehiculo
+    double Tiempo_Consumido; // Tiempo que ha consumido en recorrer los cliente y atenderlos
+    double Tiempo_Maximo;    // Maximo de tiempo para regresar al deposito
+    int Ultimo_Cliente;      // Cliente donde se encuentra el vehículo, el último de su ruta
+    int Clientes_Atendidos;  // Clientes en la ruta del vehículo sin contar al deposito
+} Vehicle;
+
+// Alineación de las matrices, una línea de cache
+#define ALINEACION_MATRIZ 64
+
+// Vecinos más cercanos que se guardan por cliente, se puede cambiar al compilar con -DNUMERO_CANDIDATOS=<k>
+#ifndef NUMERO_CANDIDATOS
+#define NUMERO_CANDIDATOS 25
+#endif
+
+// Alineación de cada bloque que sirve una arena
+#define ALINEACION_ARENA 16
+
+// Medición de fases y contadores, con -DESTADISTICAS. Sin la bandera las macros no generan código ni evalúan sus argumentos
+#ifdef ESTADISTICAS
+#include <time.h>
+#define CONTAR(Contador, Cantidad) ((Contador) += (Cantidad))
+#define INICIAR_MEDICION(Inicio) double Inicio = Tiempo_Estadisticas()
+#define TERMINAR_MEDICION(Acumulado, Inicio) ((Acumulado) += Tiempo_Estadisticas() - (Inicio))
+#else
+#define CONTAR(Contador, Cantidad) ((void)0)
+#define INICIAR_MEDICION(Inicio) ((void)0)
+#define TERMINAR_MEDICION(Acumulado, Inicio) ((void)0)
+#endif
+
+// MMAS deposita la mejor solución global en lugar de la de la iteración una de cada MMAS_CADA_MEJOR_GLOBAL iteraciones
+#ifndef MMAS_CADA_MEJOR_GLOBAL
+#define MMAS_CADA_MEJOR_GLOBAL 10
+#endif
+
+// La evaporación se acumula en la escala de las feromonas; cuando la escala sale de [ESCALA_MINIMA_FEROMONAS,
+// 1 / ESCALA_MINIMA_FEROMONAS] se pasa a la matriz para que los valores guardados no se desborden (con Rho = 0.1, cada ~2200 iteraciones).
+// Las feromonas efectivas son iguales salvo redondeo a las de evaporar toda la matriz en cada iteración, no idénticas: la escala y la
+// normalización redondean en otro orden (Colonia_Microbenchmark mide la diferencia)
+#ifndef ESCALA_MINIMA_FEROMONAS
+#define ESCALA_MINIMA_FEROMONAS 1e-100
+#endif
+
+// Potencias del atractivo con vectores de 4 double (AVX2 o SSE2 según el procesador) y filtro de destinos factibles con vectores
+// de SSE2, con GCC o Clang en x86-64. -DSIN_SIMD usa pow y el filtro escalar
+#if !defined(SIN_SIMD) && defined(__GNUC__) && defined(__x86_64__)
+#define VECTORES_SIMD
+#endif
+
+// Diferencia relativa máxima de las potencias vectoriales contra pow, con feromonas entre 1e-30 y 1e30 y Alpha <= 5
+#define TOLERANCIA_POTENCIAS 1e-13
+
+// Velocidad de los vehículos con la que se calcula el tiempo de recorrido a partir de la distancia
+#define VELOCIDAD_VEHICULO 1.0
+
+// Carpeta donde se guardan las matrices precalculadas de cada instancia, -DDIRECTORIO_CACHE=\"\" desactiva la cache
+#ifndef DIRECTORIO_CACHE
+#define DIRECTORIO_CACHE "Cache"
+#endif
+
+// Versión del archivo de cache, se incrementa si cambia su formato o la forma de calcular las matrices
+#define VERSION_CACHE 2
+#define TAM_ENCABEZADO_CACHE 64
+
+// Bloque de memoria del que se sirve la memoria temporal de una iteración, se reinicia en O(1) sin liberar nada
+typedef struct
+{
+    char *Memoria;    // Bloque reservado una vez por ejecución
+    size_t Capacidad; // Bytes del bloque
+    size_t Usado;     // Bytes servidos desde el último reinicio
+} Arena;
+
+struct Hilo_Construccion;
+
+// Estado de una hormiga: construye una solución completa con sus propios vehículos, clientes visitados y generador aleatorio.
+// Su solución (Nodos, Inicio_Ruta) es de la hormiga y vive toda la ejecución; la memoria de trabajo de la construcción la presta
+// el hilo que la construye desde su arena y solo es valida mientras se construye
+typedef struct
+{
+    bool *Visitado;                                // Clientes que ya visitó la hormiga, uno por cliente de la instancia (del hilo)
+    Vehicle *Vehiculos;                            // Tiempo y carga de cada vehículo de la hormiga (del hilo)
+    int Numero_Rutas;                              // Vehículos que ha usado la hormiga, las rutas abiertas son las primeras
+    int *Orden;                                    // Clientes en el orden en que los visitó la hormiga (del hilo)
+    int *Vehiculo_Orden;                           // Vehículo que atendió a cada cliente de Orden (del hilo)
+    int Numero_Visitados;                          // Clientes validos en Orden
+    int *Nodos;                                    // Rutas de la solución una tras otra, cada ruta empieza y termina en el deposito
+    int *Inicio_Ruta;                              // Numero_Rutas + 1 desplazamientos dentro de Nodos
+    uint64_t Estado_Aleatorio[4];                  // Estado del generador xoshiro256** de la hormiga, se siembra una sola vez por ejecución
+    int *Destinos_Posibles;                        // Destinos factibles del paso actual, uno por cliente como máximo (del hilo)
+    double *Acumulados;                            // Suma acumulada de los numeradores de Destinos_Posibles (del hilo)
+    double Distancia;                              // Distancia total de la solución construida
+    bool Completa;                                 // true si la hormiga logró visitar a todos los clientes
+    struct Hilo_Construccion *Hilo;                // Hilo que la está construyendo, NULL fuera de los hilos de la colonia
+#ifdef ESTADISTICAS
+    Estadisticas_Colonia Estadisticas;             // Contadores de la hormiga desde la última iteración
+#endif
+} Hormiga;
+
+// Feromona que deja una hormiga sobre un arco
+typedef struct
+{
+    int Origen;
+    int Destino;
+    double Delta;
+} Deposito;
+
+// Feromona de un arco después de las actualizaciones locales de ACS que hicieron las hormigas de un hilo en la iteración
+typedef struct
+{
+    int Arco;         // Índice del arco en la matriz, -1 si la entrada está libre
+    double Feromona;  // Feromona local del arco
+    double Numerador; // feromona^Alpha * heuristica con la feromona local
+} Arco_Local;
+
+// Memoria de la búsqueda local. Las rutas de la solución que se mejora son listas doblemente ligadas: los nodos 1..n-1 son los
+// clientes y la ruta r tiene su propio deposito de salida n + 2r y de llegada n + 2r + 1, así cada nodo aparece una sola vez.
+// Por cada nodo se guarda lo que permite revisar un movimiento en O(1): el tiempo de salida y la carga desde el inicio de su ruta
+// y la ventana de llegada que mantiene factible el resto de la ruta con la carga que le falta
+typedef struct
+{
+    Arena Memoria;           // Un solo bloque con todos los arreglos, se reserva al crear la colonia
+    int Numero_Rutas;        // Rutas de la solución, incluidas las que se quedaron vacías
+    int *Siguiente;          // Nodo que sigue en su ruta
+    int *Anterior;           // Nodo anterior en su ruta
+    int *Ruta;               // Ruta en la que está cada nodo
+    double *Salida;          // Tiempo de salida del nodo recorriendo su ruta desde el deposito
+    int *Carga_Prefijo;      // Carga desde el deposito hasta el nodo incluido
+    double *Llegada_Minima;  // Llegada más temprana al nodo con la que el resto de la ruta es factible
+    double *Llegada_Maxima;  // Llegada más tardía al nodo con la que el resto de la ruta es factible
+    int *Carga_Sufijo;       // Carga del nodo hasta el final de la ruta
+    bool *Pendiente;         // Clientes cuya ruta cambió desde la última vez que se buscó un movimiento para ellos
+#ifdef ESTADISTICAS
+    Estadisticas_Colonia Estadisticas; // Contadores de la búsqueda local desde la última iteración
+#endif
+} Busqueda_Local;
+
+struct Colonia;
+
+// Estado de un hilo de construcción, acumula sus depósitos de feromona sin tocar la matriz compartida
+typedef struct Hilo_Construccion
+{
+    struct Colonia *colonia; // Colonia a la que pertenece el hilo
+    int Id;                  // El hilo construye las hormigas Id, Id + Numero_Hilos, ...
+    Arena Memoria;           // Memoria temporal del hilo, se reinicia al final de cada iteración
+    Deposito *Depositos;     // Depósitos de las hormigas de este hilo en la iteración actual, dentro de Memoria
+    int Numero_Depositos;    // Depósitos validos
+    int Capacidad;           // Depósitos que caben, una solución completa por cada hormiga del hilo
+    Arco_Local *Locales;     // ACS: tabla hash de los arcos que usaron las hormigas del hilo en la iteración, dentro de Memoria;
+                             // NULL sin actualización local
+    int Mascara_Locales;     // Entradas de Locales - 1, son una potencia de 2
+    int *Actualizaciones;    // ACS: arcos en el orden en que se actualizaron, para repetirlas sobre la matriz compartida
+    int Numero_Actualizaciones;
+} Hilo_Construccion;
+
+// Estado de una ejecución de la colonia
+typedef struct Colonia
+{
+    const Instancia *instancia;                     // Instancia que se esta resolviendo
+    Configuracion_Colonia Configuracion;            // Parámetros de la colonia
+    double *feromonas;                              // Matriz de feromonas, solo se lee mientras las hormigas construyen
+    double Escala_Feromonas;                        // La feromona de un arco es max(feromonas * Escala_Feromonas, Feromona_Minima)
+    double Feromona_Minima;                         // tau_min de MMAS, 0 en las demás estrategias
+    double *heuristica;                             // visibilidad^Beta * (1/vencimiento del destino)^Gamma, fija durante la ejecución
+    double *atractivo;                              // feromona^Alpha * heuristica, se recalcula después de cada actualización de feromonas
+    Hormiga *Hormigas;                              // Una por cada hormiga de la colonia
+    Hilo_Construccion *Hilos;                       // Hilos que construyen las soluciones
+    int Numero_Hilos;                               // Número de hilos de construcción
+    pthread_t *Trabajadores;                        // Hilos 1..Hilos_Lanzados, esperan cada iteración y viven toda la ejecución
+    int Hilos_Lanzados;                             // Hilos que se lograron crear, las hormigas de los demás las construye el que llama
+    pthread_mutex_t Candado;                        // Protege Generacion, Pendientes y Terminar
+    pthread_cond_t Hay_Trabajo;                     // Hay una iteración nueva que construir o los hilos deben terminar
+    pthread_cond_t Trabajo_Terminado;               // El último hilo en terminar su parte de la iteración avisa
+    unsigned long Generacion;                       // Iteraciones entregadas a los hilos
+    int Pendientes;                                 // Hilos que no han terminado la iteración entregada
+    bool Terminar;                                  // Los hilos deben salir, solo al liberar la colonia
+    Busqueda_Local Mejora;                          // Memoria de la búsqueda local, solo la usa el hilo principal
+    double Probabilidad_Explotar;                   // Q0 de ACS: probabilidad de ir al destino con mayor numerador, 0 en las demás
+    double Feromona_Inicial;                        // Valor al que se inician o reinician las feromonas (tau0 en ACS, tau_max en MMAS)
+    bool Feromonas_Escaladas;                       // MMAS y ACS: las feromonas ya se escalaron con la primera solución completa
+    int Iteraciones_Sin_Mejora;                     // Iteraciones seguidas sin mejorar la mejor solución
+} Colonia;
+
+// Reserva el bloque de la arena
+static bool Crear_Arena(Arena *arena, size_t Capacidad)
+{
+    arena->Memoria = malloc(Capacidad > 0 ? Capacidad : 1);
+    arena->Capacidad = Capacidad;
+    arena->Usado = 0;
+    return arena->Memoria != NULL;
+}
+
+// Sirve Tam bytes alineados de la arena, NULL si ya no caben
+static void *Arena_Reservar(Arena *arena, size_t Tam)
+{
+    size_t Inicio = (arena->Usado + ALINEACION_ARENA - 1) / ALINEACION_ARENA * ALINEACION_ARENA;
+    if (Inicio > arena->Capacidad || Tam > arena->Capacidad - Inicio)
+    {
+        return NULL;
+    }
+    arena->Usado = Inicio + Tam;
+    return arena->Memoria + Inicio;
+}
+
+// Todo lo servido por la arena deja de ser valido
+static void Reiniciar_Arena(Arena *arena)
+{
+    arena->Usado = 0;
+}
+
+static void Liberar_Arena(Arena *arena)
+{
+    free(arena->Memoria);
+    arena->Memoria = NULL;
+    arena->Capacidad = 0;
+    arena->Usado = 0;
+}
+
+#ifdef ESTADISTICAS
+// Tiempo monotónico en segundos para las mediciones
+static double Tiempo_Estadisticas(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+// Suma los contadores de una hormiga al total de la ejecución y los deja en cero para la siguiente iteración
+static void Sumar_Estadisticas(Estadisticas_Colonia *Total, Estadisticas_Colonia *Hormiga_Iteracion)
+{
+    Total->Tiempo_Distancia += Hormiga_Iteracion->Tiempo_Distancia;
+    Total->Candidatos_Revisados += Hormiga_Iteracion->Candidatos_Revisados;
+    Total->Candidatos_Factibles += Hormiga_Iteracion->Candidatos_Factibles;
+    Total->Revisiones_Completas += Hormiga_Iteracion->Revisiones_Completas;
+    Total->Rutas_Abiertas += Hormiga_Iteracion->Rutas_Abiertas;
+    Total->Movimientos_Evaluados += Hormiga_Iteracion->Movimientos_Evaluados;
+    Total->Movimientos_Aplicados += Hormiga_Iteracion->Movimientos_Aplicados;
+    memset(Hormiga_Iteracion, 0, sizeof(*Hormiga_Iteracion));
+}
+#endif
+
+// Funcion para inizializar la matriz de feromonas con el mismo Valor en todos los arcos
+static void inicializar_feromonas(Colonia *colonia, double Valor)
+{
+    int size = colonia->instancia->Numero_Clientes;
+    colonia->Escala_Feromonas = 1.0;
+    for (int i = 0; i < size; i++)
+    {
+        for (int j = 0; j < size; j++)
+        {
+            if (i != j)
+            {
+                colonia->feromonas[i * size + j] = Valor; // Valor en toda la matriz excepto la diagonal
+            }
+            else
+            {
+                colonia->feromonas[i * size + j] = 0.0; // La diagonal debe ser cero
+            }
+        }
+    }
+}
+
+// Función para retornar la distancia con respecto a los clientes que nos llegue
+static double Calcular_Distancia(const Columnas_Clientes *clientes, int Origen, int Destino)
+{
+    double distancia = sqrt(pow(clientes->xCoord[Origen] - clientes->xCoord[Destino], 2) +
+                            pow(clientes->yCoord[Origen] - clientes->yCoord[Destino], 2));
+    return distancia;
+}
+
+static double Calcular_Tiempo_Recorrido(double Distancia)
+{
+    double Tiempo = Distancia / VELOCIDAD_VEHICULO;
+    return Tiempo;
+}
+
+// Función para inicializar las matrices de distancia, tiempo de recorrido y visibilidad entre clientes, se calculan una sola vez por instancia
+static void inicializar_matrices(Instancia *instancia)
+{
+    int size = instancia->Numero_Clientes;
+    for (int i = 0; i < size; i++)
+    {
+        for (int j = 0; j < size; j++)
+        {
+            // Cálculo de la distancia euclidiana entre dos clientes
+            double distancia = Calcular_Distancia(&instancia->columnas, i, j);
+            instancia->distancias[i * size + j] = distancia;
+            instancia->tiempos[i * size + j] = Calcular_Tiempo_Recorrido(distancia);
+            if (i != j)
+            {
+                instancia->visibilidad[i * size + j] = 1.0 / distancia; // Inversa de la distancia como visibilidad
+            }
+            else
+            {
+                instancia->visibilidad[i * size + j] = 0.0; // La diagonal debe ser cero
+            }
+        }
+    }
+}
+
+// Construye la lista de candidatos de cada cliente: sus Numero_Candidatos clientes más cercanos (mayor visibilidad),
+// sin el deposito ni el mismo cliente, ordenados del más cercano al más lejano
+static void inicializar_candidatos(Instancia *instancia)
+{
+    int size = instancia->Numero_Clientes;
+    int k = instancia->Numero_Candidatos;
+    for (int i = 0; i < size; i++)
+    {
+        int *Lista = &instancia->candidatos[i * k];
+        const double *Visibilidad = &instancia->visibilidad[i * size];
+        int Encontrados = 0;
+        for (int j = 1; j < size; j++)
+        {
+            if (j == i || (Encontrados == k && Visibilidad[j] <= Visibilidad[Lista[k - 1]]))
+            {
+                continue;
+            }
+            // Inserción ordenada, si la lista ya está llena se descarta el más lejano
+            int pos = Encontrados < k ? Encontrados++ : k - 1;
+            while (pos > 0 && Visibilidad[Lista[pos - 1]] < Visibilidad[j])
+            {
+                Lista[pos] = Lista[pos - 1];
+                pos--;
+            }
+            Lista[pos] = j;
+        }
+    }
+}
+
+// Copia de la matriz de tiempos el tiempo de recorrido de cada cliente a cada uno de sus candidatos, en el orden de la lista
+static void inicializar_tiempos_candidatos(Instancia *instancia)
+{
+    int size = instancia->Numero_Clientes;
+    int k = instancia->Numero_Candidatos;
+    for (int i = 0; i < size; i++)
+    {
+        for (int c = 0; c < k; c++)
+        {
+            instancia->tiempos_candidatos[i * k + c] = instancia->tiempos[i * size + instancia->candidatos[i * k + c]];
+        }
+    }
+}
+
+// Función para calcular la parte del numerador que no cambia durante la ejecución: visibilidad y fecha de vencimiento del destino
+static void inicializar_heuristica(Colonia *colonia)
+{
+    int n = colonia->instancia->Numero_Clientes;
+    for (int j = 0; j < n; j++)
+    {
+        double tiempo_hasta_vencimiento = colonia->instancia->clientes[j].Fecha_Vencimiento;
+
+        // Ajusta la importancia de los tiempos
+        double Valor_Tiempos = (tiempo_hasta_vencimiento > 0) ? 1.0 / tiempo_hasta_vencimiento : 0.0;
+        double Factor_Tiempos = pow(Valor_Tiempos, colonia->Configuracion.Gamma);
+        for (int i = 0; i < n; i++)
+        {
+            //(1/(Origen,destino))^Beta de la matriz inversa de la distancia
+            colonia->heuristica[i * n + j] = pow(colonia->instancia->visibilidad[i * n + j], colonia->Configuracion.Beta) * Factor_Tiempos;
+        }
+    }
+}
+
+// Feromona efectiva del arco i (fuera de la diagonal), con la evaporación pendiente
+static double Feromona_Arco(const Colonia *colonia, int i)
+{
+    return fmax(colonia->feromonas[i] * colonia->Escala_Feromonas, colonia->Feromona_Minima);
+}
+
+// Guarda Valor como feromona efectiva del arco i, los depósitos se escriben en la escala actual
+static void Fijar_Feromona_Arco(Colonia *colonia, int i, double Valor)
+{
+    colonia->feromonas[i] = Valor / colonia->Escala_Feromonas;
+}
+
+// Vista de las feromonas para Copiar_Feromonas y el observador
+static Feromonas_Colonia Feromonas_Actuales(const Colonia *colonia)
+{
+    Feromonas_Colonia feromonas = {colonia->feromonas, colonia->Escala_Feromonas, colonia->Feromona_Minima,
+                                   colonia->instancia->Numero_Clientes};
+    return feromonas;
+}
+
+void Copiar_Feromonas(const Feromonas_Colonia *feromonas, double *Destino)
+{
+    int n = feromonas->Numero_Clientes;
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            Destino[i * n + j] = i != j ? fmax(feromonas->Valores[i * n + j] * feromonas->Escala, feromonas->Minima) : 0.0;
+        }
+    }
+}
+
+// Pasa la evaporación pendiente a la matriz y deja la escala en 1
+static void Normalizar_Feromonas(Colonia *colonia)
+{
+    Feromonas_Colonia feromonas = Feromonas_Actuales(colonia);
+    Copiar_Feromonas(&feromonas, colonia->feromonas);
+    colonia->Escala_Feromonas = 1.0;
+}
+
+// Evapora todas las feromonas en tiempo constante: solo cambia la escala y el límite inferior, la matriz se toca únicamente
+// cuando hay que normalizarla
+static void Evaporar_Feromonas(Colonia *colonia, double Minima)
+{
+    colonia->Escala_Feromonas *= 1 - colonia->Configuracion.Rho;
+    colonia->Feromona_Minima = Minima;
+    double Escala = fabs(colonia->Escala_Feromonas);
+    if (!(Escala >= ESCALA_MINIMA_FEROMONAS && Escala <= 1.0 / ESCALA_MINIMA_FEROMONAS))
+    {
+        Normalizar_Feromonas(colonia);
+    }
+}
+
+// Atractivo[k] = max(Feromonas[k] * Escala, Minima)^Alpha * Heuristica[k] con pow, un destino a la vez
+static void Potencias_Escalar(const double *Feromonas, const double *Heuristica, int Cantidad, double Escala, double Minima,
+                              double Alpha, double *Atractivo)
+{
+    for (int k = 0; k < Cantidad; k++)
+    {
+        Atractivo[k] = pow(fmax(Feromonas[k] * Escala, Minima), Alpha) * Heuristica[k];
+    }
+}
+
+#ifdef VECTORES_SIMD
+// Vectores de 4 double con las extensiones de GCC; sin AVX el compilador parte cada operación en dos de SSE2. Se pasan por
+// apuntador para que el ABI de los vectores de 32 bytes no dependa de si la función se compiló con AVX
+typedef double Vector_Double __attribute__((vector_size(32)));
+typedef long long Vector_Entero __attribute__((vector_size(32)));
+typedef unsigned long long Vector_Bits __attribute__((vector_size(32)));
+
+// Con |Alpha * log(tau)| hasta LIMITE_EXPONENTE el resultado es un double normal y exp no necesita casos especiales
+#define LIMITE_EXPONENTE 700.0
+
+// Sumar 1.5 * 2^52 redondea al entero más cercano y lo deja en los bits bajos de la mantisa
+#define REDONDEO_ENTERO 0x1.8p52
+#define BITS_REDONDEO_ENTERO 0x4338000000000000LL
+
+// Toma a donde Mascara es verdadera y b en los demás carriles
+#define ELEGIR(Mascara, a, b) ((Vector_Double)(((Mascara) & (Vector_Entero)(a)) | (~(Mascara) & (Vector_Entero)(b))))
+
+// -1 en los carriles donde el entero v es negativo y 0 en los demás. Las comparaciones se hacen con restas de enteros sobre los
+// bits de los double (para double no negativos el orden de los bits es el de los números) porque SSE2 no tiene comparaciones
+// de 64 bits y GCC parte las de vectores de double de 32 bytes en comparaciones escalares
+#define NEGATIVO(v) (-(Vector_Entero)((Vector_Bits)(v) >> 63))
+
+// Logaritmo natural de x normal y positivo, el de fdlibm: x = 2^e * m con m en [sqrt(2)/2, sqrt(2)) y
+// log(m) = 2s + s^3 * P(s^2) con s = (m - 1) / (m + 1), error menor a 1 ulp
+static inline __attribute__((always_inline)) void Logaritmo(const Vector_Double *x, Vector_Double *Resultado)
+{
+    const double Lg1 = 6.666666666666735130e-01, Lg2 = 3.999999999940941908e-01, Lg3 = 2.857142874366239149e-01,
+                 Lg4 = 2.222219843214978396e-01, Lg5 = 1.818357216161805012e-01, Lg6 = 1.531383769920937332e-01,
+                 Lg7 = 1.479819860511658591e-01;
+    const double Ln2_Alto = 6.93147180369123816490e-01, Ln2_Bajo = 1.90821492927058770002e-10;
+
+    Vector_Bits Bits = (Vector_Bits)*x;
+    Vector_Entero Exponente = (Vector_Entero)((Bits >> 52) & 0x7ff) - 1023;
+    Vector_Double m = (Vector_Double)((Bits & 0x000fffffffffffffULL) | 0x3ff0000000000000ULL);
+    Vector_Double Raiz2 = (Vector_Double){0} + M_SQRT2;
+    Vector_Entero Mayor = NEGATIVO((Vector_Entero)Raiz2 - (Vector_Entero)m);
+    m = ELEGIR(Mayor, m * 0.5, m);
+    Exponente -= Mayor; // La máscara vale -1 en los carriles que se dividieron entre 2
+    Vector_Double e = (Vector_Double)(Exponente + BITS_REDONDEO_ENTERO) - REDONDEO_ENTERO;
+
+    Vector_Double f = m - 1.0;
+    Vector_Double s = f / (2.0 + f);
+    Vector_Double z = s * s;
+    Vector_Double w = z * z;
+    Vector_Double R = w * (Lg2 + w * (Lg4 + w * Lg6)) + z * (Lg1 + w * (Lg3 + w * (Lg5 + w * Lg7)));
+    Vector_Double Medio_Cuadrado = 0.5 * f * f;
+    *Resultado = e * Ln2_Alto - ((Medio_Cuadrado - (s * (Medio_Cuadrado + R) + e * Ln2_Bajo)) - f);
+}
+
+// Exponencial de y con |y| <= LIMITE_EXPONENTE, la de fdlibm: y = k * ln(2) + r con |r| <= ln(2) / 2 y
+// exp(r) = 1 + 2r / (2 - c) con c = r - r^2 * P(r^2), error menor a 1 ulp
+static inline __attribute__((always_inline)) void Exponencial(const Vector_Double *y, Vector_Double *Resultado)
+{
+    const double P1 = 1.66666666666666019037e-01, P2 = -2.77777777770155933842e-03, P3 = 6.61375632143793436117e-05,
+                 P4 = -1.65339022054652515390e-06, P5 = 4.13813679705723846039e-08;
+    const double Inverso_Ln2 = 1.44269504088896338700e+00;
+    const double Ln2_Alto = 6.93147180369123816490e-01, Ln2_Bajo = 1.90821492927058770002e-10;
+
+    Vector_Double Redondeado = *y * Inverso_Ln2 + REDONDEO_ENTERO;
+    Vector_Double k = Redondeado - REDONDEO_ENTERO;
+    Vector_Entero Exponente = (Vector_Entero)Redondeado - BITS_REDONDEO_ENTERO;
+
+    Vector_Double Alto = *y - k * Ln2_Alto;
+    Vector_Double Bajo = k * Ln2_Bajo;
+    Vector_Double r = Alto - Bajo;
+    Vector_Double t = r * r;
+    Vector_Double c = r - t * (P1 + t * (P2 + t * (P3 + t * (P4 + t * P5))));
+    Vector_Double Mantisa = 1.0 - ((Bajo - (r * c) / (2.0 - c)) - Alto);
+    *Resultado = Mantisa * (Vector_Double)((Exponente + 1023) << 52);
+}
+
+// Potencias_Escalar de 4 en 4 en log-espacio: exp(Alpha * log(tau)) * heuristica, con Minima >= 0. Los bloques con alguna
+// feromona cero, subnormal o infinita, o con un exponente fuera de ±LIMITE_EXPONENTE, y los destinos que sobran se calculan con
+// pow. No usa FMA, así que las versiones AVX2 y SSE2 dan exactamente los mismos números. Contra pow la diferencia relativa es a
+// lo más unos cuantos ulp por cada unidad de |Alpha * log(tau)|, dentro de TOLERANCIA_POTENCIAS
+static inline __attribute__((always_inline)) void Potencias_Vector(const double *Feromonas, const double *Heuristica, int Cantidad,
+                                                                   double Escala, double Minima, double Alpha, double *Atractivo)
+{
+    int k = 0;
+    for (; k + 4 <= Cantidad; k += 4)
+    {
+        Vector_Double x, h;
+        memcpy(&x, Feromonas + k, sizeof(x));
+        memcpy(&h, Heuristica + k, sizeof(h));
+        x = x * Escala;
+        Vector_Double Minimas = (Vector_Double){0} + Minima;
+        x = ELEGIR(NEGATIVO((Vector_Entero)x - (Vector_Entero)Minimas), Minimas, x);
+        Vector_Double y;
+        Logaritmo(&x, &y);
+        y = Alpha * y;
+
+        // x debe ser un double normal positivo (exponente con signo entre 1 y 2046) y |y| a lo más LIMITE_EXPONENTE
+        Vector_Entero Exponente = (Vector_Entero)((Vector_Bits)x >> 52);
+        Vector_Double Limite = (Vector_Double){0} + LIMITE_EXPONENTE;
+        Vector_Entero Absoluto = (Vector_Entero)y & 0x7fffffffffffffffLL;
+        Vector_Entero Invalido = NEGATIVO(Exponente - 1) | NEGATIVO(2046 - Exponente) | NEGATIVO((Vector_Entero)Limite - Absoluto);
+        if (Invalido[0] | Invalido[1] | Invalido[2] | Invalido[3])
+        {
+            Potencias_Escalar(Feromonas + k, Heuristica + k, 4, Escala, Minima, Alpha, Atractivo + k);
+            continue;
+        }
+        Vector_Double Resultado;
+        Exponencial(&y, &Resultado);
+        Resultado = Resultado * h;
+        memcpy(Atractivo + k, &Resultado, sizeof(Resultado));
+    }
+    Potencias_Escalar(Feromonas + k, Heuristica + k, Cantidad - k, Escala, Minima, Alpha, Atractivo + k);
+}
+
+__attribute__((target("avx2"))) static void Potencias_AVX2(const double *Feromonas, const double *Heuristica, int Cantidad,
+                                                            double Escala, double Minima, double Alpha, double *Atractivo)
+{
+    Potencias_Vector(Feromonas, Heuristica, Cantidad, Escala, Minima, Alpha, Atractivo);
+}
+
+static void Potencias_SSE2(const double *Feromonas, const double *Heuristica, int Cantidad, double Escala, double Minima,
+                           double Alpha, double *Atractivo)
+{
+    Potencias_Vector(Feromonas, Heuristica, Cantidad, Escala, Minima, Alpha, Atractivo);
+}
+#endif
+
+// Numeradores de Cantidad destinos contiguos. Con Alpha = 1 no hace falta ninguna potencia; en los demás casos se usa la versión
+// vectorial que soporta el procesador. En renglones de 100 a 1000 destinos la de AVX2 tarda entre 2.1 y 2.8 veces menos que pow
+// y la de SSE2 cerca de 1.6 veces menos.
+// El denominador y las sumas acumuladas no se calculan aquí sino en Calculo_Probabilidad, en un ciclo escalar aparte: dependen de
+// los destinos factibles de cada paso (unos 25 candidatos sueltos, no un renglón contiguo), mientras que los numeradores cambian
+// una vez por iteración; y cada suma depende de la anterior, así que hacerla por vectores cambiaría el orden de las sumas, el
+// redondeo de la ruleta y con él los resultados de una misma semilla
+static void Potencias_Atractivo(const double *Feromonas, const double *Heuristica, int Cantidad, double Escala, double Minima,
+                                double Alpha, double *Atractivo)
+{
+    if (Alpha == 1.0)
+    {
+        // Igual que fmax para feromonas que no son NaN, sin llamar a la biblioteca matemática
+        for (int k = 0; k < Cantidad; k++)
+        {
+            double Feromona = Feromonas[k] * Escala;
+            Atractivo[k] = (Feromona < Minima ? Minima : Feromona) * Heuristica[k];
+        }
+        return;
+    }
+#ifdef VECTORES_SIMD
+    if (__builtin_cpu_supports("avx2"))
+    {
+        Potencias_AVX2(Feromonas, Heuristica, Cantidad, Escala, Minima, Alpha, Atractivo);
+    }
+    else
+    {
+        Potencias_SSE2(Feromonas, Heuristica, Cantidad, Escala, Minima, Alpha, Atractivo);
+    }
+#else
+    Potencias_Escalar(Feromonas, Heuristica, Cantidad, Escala, Minima, Alpha, Atractivo);
+#endif
+}
+
+// Recalcula el numerador de cada arco con las feromonas actuales, se llama cada vez que cambian las feromonas.
+// (Origen,destino)^Alpha*(1/(Origen,destino))^Beta*(1/vencimiento)^Gamma = Numerador, la heurística ya tiene los dos últimos
+// factores así que solo falta la potencia de la feromona, un renglón a la vez
+static void Actualizar_Atractivo(Colonia *colonia)
+{
+    int n = colonia->instancia->Numero_Clientes;
+    double Alpha = colonia->Configuracion.Alpha;
+    for (int i = 0; i < n; i++)
+    {
+        Potencias_Atractivo(&colonia->feromonas[i * n], &colonia->heuristica[i * n], n, colonia->Escala_Feromonas,
+                            colonia->Feromona_Minima, Alpha, &colonia->atractivo[i * n]);
+        colonia->atractivo[i * n + i] = pow(0.0, Alpha) * colonia->heuristica[i * n + i]; // La diagonal no tiene feromona
+    }
+}
+
+// Recalcula el numerador de un solo arco, para las estrategias que cambian pocas feromonas por iteración
+static void Actualizar_Atractivo_Arco(Colonia *colonia, int Origen, int Destino)
+{
+    int i = Origen * colonia->instancia->Numero_Clientes + Destino;
+    colonia->atractivo[i] = pow(Feromona_Arco(colonia, i), colonia->Configuracion.Alpha) * colonia->heuristica[i];
+}
+
+// Función que devuelve el numerador necesario para determinar la probabilidad de seleccionar un destino en la construcción de la ruta
+static double Calcular_Numerador(const Colonia *colonia, int Origen, int Destino)
+{
+    return colonia->atractivo[Origen * colonia->instancia->Numero_Clientes + Destino];
+}
+
+// Entrada de la tabla local del hilo que guarda el arco, o la entrada libre donde iría. La tabla tiene al menos el doble de
+// entradas que arcos puede usar el hilo en una iteración, así que siempre queda alguna libre
+static Arco_Local *Buscar_Arco_Local(const Hilo_Construccion *Hilo, int Arco)
+{
+    int i = (int)(((uint64_t)Arco * 0x9E3779B97F4A7C15ULL) >> 32) & Hilo->Mascara_Locales;
+    while (Hilo->Locales[i].Arco != Arco && Hilo->Locales[i].Arco != -1)
+    {
+        i = (i + 1) & Hilo->Mascara_Locales;
+    }
+    return &Hilo->Locales[i];
+}
+
+// Numerador de un destino para una hormiga de ACS: el de la tabla local de su hilo si alguna hormiga del hilo ya usó el arco
+// en esta iteración, si no el de la matriz compartida
+static double Calcular_Numerador_Local(const Colonia *colonia, const Hormiga *hormiga, int Origen, int Destino)
+{
+    int Arco = Origen * colonia->instancia->Numero_Clientes + Destino;
+    const Arco_Local *Local = Buscar_Arco_Local(hormiga->Hilo, Arco);
+    return Local->Arco == Arco ? Local->Numerador : colonia->atractivo[Arco];
+}
+
+// Actualización local de ACS del arco que acaba de recorrer la hormiga: tau = (1 - Xi) * tau + Xi * tau0 en la tabla de su hilo.
+// Las hormigas del hilo la ven desde el siguiente paso y la colonia la repite sobre la matriz compartida al terminar la iteración
+static void Actualizar_Arco_Local(const Colonia *colonia, Hormiga *hormiga, int Origen, int Destino)
+{
+    Hilo_Construccion *Hilo = hormiga->Hilo;
+    if (Hilo == NULL || Hilo->Locales == NULL)
+    {
+        return;
+    }
+    int Arco = Origen * colonia->instancia->Numero_Clientes + Destino;
+    Arco_Local *Local = Buscar_Arco_Local(Hilo, Arco);
+    if (Local->Arco != Arco)
+    {
+        Local->Arco = Arco;
+        Local->Feromona = Feromona_Arco(colonia, Arco);
+    }
+    double Xi = colonia->Configuracion.Xi;
+    Local->Feromona = (1 - Xi) * Local->Feromona + Xi * colonia->Feromona_Inicial;
+    Local->Numerador = pow(Local->Feromona, colonia->Configuracion.Alpha) * colonia->heuristica[Arco];
+    Hilo->Actualizaciones[Hilo->Numero_Actualizaciones++] = Arco;
+}
+
+// Avanza un estado splitmix64, solo se usa para sembrar los generadores de las hormigas
+static uint64_t Siguiente_Splitmix64(uint64_t *Estado)
+{
+    uint64_t z = (*Estado += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static uint64_t Rotar_Izquierda(uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+// Siguiente número del generador xoshiro256** de la hormiga
+static uint64_t Siguiente_Aleatorio(Hormiga *hormiga)
+{
+    uint64_t *e = hormiga->Estado_Aleatorio;
+    uint64_t Resultado = Rotar_Izquierda(e[1] * 5, 7) * 9;
+    uint64_t t = e[1] << 17;
+    e[2] ^= e[0];
+    e[3] ^= e[1];
+    e[1] ^= e[2];
+    e[0] ^= e[3];
+    e[2] ^= t;
+    e[3] = Rotar_Izquierda(e[3], 45);
+    return Resultado;
+}
+
+// Número real uniforme en [0, 1) con 53 bits de resolución
+static double Aleatorio_Real(Hormiga *hormiga)
+{
+    return (double)(Siguiente_Aleatorio(hormiga) >> 11) * 0x1.0p-53;
+}
+
+// DEVUELVE UN ENTERO ENTRE 0 Y n-1
+static int Aleatorio_Entero(Hormiga *hormiga, int n)
+{
+    return (int)(Aleatorio_Real(hormiga) * n);
+}
+
+// Siembra el generador de la hormiga a partir de la semilla de la ejecución y su número, independiente del número de hilos
+static void Sembrar_Hormiga(Hormiga *hormiga, unsigned int Semilla, int Numero_Hormiga)
+{
+    uint64_t Estado = ((uint64_t)Semilla << 32) ^ (uint64_t)Numero_Hormiga;
+    for (int i = 0; i < 4; i++)
+    {
+        hormiga->Estado_Aleatorio[i] = Siguiente_Splitmix64(&Estado);
+    }
+}
+
+// Función donde selecciona un índice con probabilidad proporcional a su numerador: un solo número aleatorio y búsqueda binaria
+// sobre las sumas acumuladas sin normalizar
+static int Seleccion_Parte(Hormiga *hormiga, const double *Acumulados, int Num_Probabilidades)
+{
+    double Total = Acumulados[Num_Probabilidades - 1];
+
+    // Si todos los numeradores son cero (o alguno es infinito) la ruleta no sirve y se elige de manera uniforme
+    if (!(Total > 0.0) || isinf(Total))
+    {
+        return Aleatorio_Entero(hormiga, Num_Probabilidades);
+    }
+
+    double Aleatorio = Aleatorio_Real(hormiga) * Total;
+
+    // Primer índice cuya suma acumulada supera al número aleatorio
+    int Inicio = 0;
+    int Fin = Num_Probabilidades - 1;
+    while (Inicio < Fin)
+    {
+        int Medio = (Inicio + Fin) / 2;
+        if (Acumulados[Medio] > Aleatorio)
+        {
+            Fin = Medio;
+        }
+        else
+        {
+            Inicio = Medio + 1;
+        }
+    }
+    return Inicio;
+}
+
+// Los filtros de destinos revisan Cantidad destinos de un origen y dejan en Destinos_Posibles, en el mismo orden, aquellos a los
+// que el vehículo puede ir: no se han visitado, se llega dentro de su ventana de tiempo y cabe su demanda. Tiempos[k] es el tiempo
+// de recorrido del origen al k-ésimo destino, que es Destinos[k] o, si Destinos es NULL, el cliente k. No hay saltos que dependan
+// de los datos: cada destino se escribe en la siguiente posición libre de Destinos_Posibles y la posición solo avanza si es
+// factible, así que Destinos_Posibles debe tener lugar para Cantidad destinos. Devuelven cuántos destinos quedaron
+
+// Filtro escalar a partir del destino Inicio, con Numero destinos ya aceptados
+static int Filtrar_Escalar(const Instancia *instancia, const bool *Visitado, const Vehicle *Vehiculo, const int *Destinos,
+                           const double *Tiempos, int Inicio, int Cantidad, int *Destinos_Posibles, int Numero)
+{
+    const Columnas_Clientes *clientes = &instancia->columnas;
+    double Carga = Vehiculo->capacity_restant;
+    double Capacidad = Vehiculo->capacity;
+    for (int k = Inicio; k < Cantidad; k++)
+    {
+        int Destino = Destinos != NULL ? Destinos[k] : k;
+        double Llegada = Vehiculo->Tiempo_Consumido + Tiempos[k];
+        Destinos_Posibles[Numero] = Destino;
+        Numero += !Visitado[Destino] & (Llegada >= clientes->Tiempo_Inicio[Destino]) &
+                  (Llegada <= clientes->Fecha_Vencimiento[Destino]) & (Carga + clientes->Demanda[Destino] <= Capacidad);
+    }
+    return Numero;
+}
+
+#ifdef VECTORES_SIMD
+// Vectores de 2 double, los de SSE2. Con los de 4 GCC parte las comparaciones de double en comparaciones escalares si no hay AVX,
+// y como los datos de los candidatos se juntan de a uno por índice AVX2 casi no ganaría nada
+typedef double Vector_Par __attribute__((vector_size(16)));
+typedef long long Vector_Par_Entero __attribute__((vector_size(16)));
+
+// Valores de la columna para los destinos k y k + 1: una sola carga si son los clientes k y k + 1, si no uno por uno
+static inline __attribute__((always_inline)) Vector_Par Juntar_Par(const double *Columna, const int *Destinos, int k, int a, int b)
+{
+    Vector_Par Valores = {Columna[a], Columna[b]};
+    if (Destinos == NULL)
+    {
+        memcpy(&Valores, Columna + k, sizeof(Valores));
+    }
+    return Valores;
+}
+
+// Filtro de 2 en 2 destinos: las tres comparaciones y la de visitado dan máscaras que se combinan con AND
+static inline __attribute__((always_inline)) int Filtrar_Vector(const Instancia *instancia, const bool *Visitado,
+                                                                const Vehicle *Vehiculo, const int *Destinos,
+                                                                const double *Tiempos, int Cantidad, int *Destinos_Posibles)
+{
+    const Columnas_Clientes *clientes = &instancia->columnas;
+    Vector_Par Tiempo = (Vector_Par){0} + Vehiculo->Tiempo_Consumido;
+    Vector_Par Carga = (Vector_Par){0} + Vehiculo->capacity_restant;
+    Vector_Par Capacidad = (Vector_Par){0} + Vehiculo->capacity;
+    int Numero = 0;
+    int k = 0;
+    for (; k + 2 <= Cantidad; k += 2)
+    {
+        int a = Destinos != NULL ? Destinos[k] : k;
+        int b = Destinos != NULL ? Destinos[k + 1] : k + 1;
+        Vector_Par Recorrido;
+        memcpy(&Recorrido, Tiempos + k, sizeof(Recorrido));
+        Vector_Par Llegada = Tiempo + Recorrido;
+        Vector_Par Inicio = Juntar_Par(clientes->Tiempo_Inicio, Destinos, k, a, b);
+        Vector_Par Vencimiento = Juntar_Par(clientes->Fecha_Vencimiento, Destinos, k, a, b);
+        Vector_Par Demanda = Juntar_Par(clientes->Demanda, Destinos, k, a, b);
+
+        // Visitado vale 0 o 1, al restarle 1 queda -1 (verdadero) en los destinos libres
+        Vector_Par_Entero Factible = ((Vector_Par_Entero){Visitado[a], Visitado[b]} - 1) & (Llegada >= Inicio) &
+                                     (Llegada <= Vencimiento) & (Carga + Demanda <= Capacidad);
+        Destinos_Posibles[Numero] = a;
+        Numero -= (int)Factible[0];
+        Destinos_Posibles[Numero] = b;
+        Numero -= (int)Factible[1];
+    }
+    return Filtrar_Escalar(instancia, Visitado, Vehiculo, Destinos, Tiempos, k, Cantidad, Destinos_Posibles, Numero);
+}
+#endif
+
+// Filtro de los candidatos del origen, con los tiempos del renglón de tiempos_candidatos
+static int Filtrar_Candidatos(const Instancia *instancia, const bool *Visitado, const Vehicle *Vehiculo, int Origen,
+                              int *Destinos_Posibles)
+{
+    int k = instancia->Numero_Candidatos;
+    const int *Candidatos = &instancia->candidatos[Origen * k];
+    const double *Tiempos = &instancia->tiempos_candidatos[Origen * k];
+#ifdef VECTORES_SIMD
+    return Filtrar_Vector(instancia, Visitado, Vehiculo, Candidatos, Tiempos, k, Destinos_Posibles);
+#else
+    return Filtrar_Escalar(instancia, Visitado, Vehiculo, Candidatos, Tiempos, 0, k, Destinos_Posibles, 0);
+#endif
+}
+
+// Filtro de todos los clientes, con el renglón del origen en la matriz de tiempos
+static int Filtrar_Todos(const Instancia *instancia, const bool *Visitado, const Vehicle *Vehiculo, int Origen,
+                         int *Destinos_Posibles)
+{
+    int n = instancia->Numero_Clientes;
+    const double *Tiempos = &instancia->tiempos[Origen * n];
+#ifdef VECTORES_SIMD
+    return Filtrar_Vector(instancia, Visitado, Vehiculo, NULL, Tiempos, n, Destinos_Posibles);
+#else
+    return Filtrar_Escalar(instancia, Visitado, Vehiculo, NULL, Tiempos, 0, n, Destinos_Posibles, 0);
+#endif
+}
+
+// Función para la construcción de rutas utilizando el algoritmo de colonia de hormigas
+static bool Calculo_Probabilidad(const Colonia *colonia, Hormiga *hormiga, int Indice_Vehiculo)
+{
+    const Customer *Destinos = colonia->instancia->clientes;
+    Vehicle *Vehiculo = &hormiga->Vehiculos[Indice_Vehiculo];
+
+    // Cliente donde se encuentra el vehículo
+    int indice_ult = Vehiculo->Ultimo_Cliente;
+
+    // Destinos que aún no han sido seleccionados y son factibles, en el arreglo de la hormiga para no reservar memoria en cada paso
+    int *Destinos_Posibles = hormiga->Destinos_Posibles;
+
+    // Primero se buscan destinos solo entre los vecinos más cercanos del origen
+    CONTAR(hormiga->Estadisticas.Candidatos_Revisados, colonia->instancia->Numero_Candidatos);
+    int Numero_DestinosPosibles = Filtrar_Candidatos(colonia->instancia, hormiga->Visitado, Vehiculo, indice_ult, Destinos_Posibles);
+
+    // Si ningún vecino es factible se revisan todos los clientes
+    if (Numero_DestinosPosibles == 0)
+    {
+        CONTAR(hormiga->Estadisticas.Revisiones_Completas, 1);
+        CONTAR(hormiga->Estadisticas.Candidatos_Revisados, colonia->instancia->Numero_Clientes);
+        Numero_DestinosPosibles = Filtrar_Todos(colonia->instancia, hormiga->Visitado, Vehiculo, indice_ult, Destinos_Posibles);
+    }
+
+    CONTAR(hormiga->Estadisticas.Candidatos_Factibles, Numero_DestinosPosibles);
+    if (Numero_DestinosPosibles == 0)
+    {
+        return false;
+    }
+
+    // En ACS la hormiga ve las actualizaciones locales de su hilo
+    bool Hay_Locales = hormiga->Hilo != NULL && hormiga->Hilo->Locales != NULL;
+
+    // En ACS, con probabilidad Q0 va directo al destino con mayor numerador; se decide antes de todo porque entonces no hace
+    // falta la suma acumulada
+    bool Explotar = colonia->Probabilidad_Explotar > 0.0 && Aleatorio_Real(hormiga) < colonia->Probabilidad_Explotar;
+    int Elegido;
+    if (Explotar)
+    {
+        Elegido = Destinos_Posibles[0];
+        double Mayor = Hay_Locales ? Calcular_Numerador_Local(colonia, hormiga, indice_ult, Elegido)
+                                   : Calcular_Numerador(colonia, indice_ult, Elegido);
+        for (int i = 1; i < Numero_DestinosPosibles; i++)
+        {
+            double Numerador = Hay_Locales ? Calcular_Numerador_Local(colonia, hormiga, indice_ult, Destinos_Posibles[i])
+                                           : Calcular_Numerador(colonia, indice_ult, Destinos_Posibles[i]);
+            if (Numerador > Mayor)
+            {
+                Mayor = Numerador;
+                Elegido = Destinos_Posibles[i];
+            }
+        }
+    }
+    else
+    {
+        // Suma acumulada de los numeradores de cada destino posible, el último es el denominador. Es escalar y en orden a
+        // propósito, ver Potencias_Atractivo
+        double Denominador = 0;
+        for (int i = 0; i < Numero_DestinosPosibles; i++)
+        {
+            Denominador = Denominador + (Hay_Locales ? Calcular_Numerador_Local(colonia, hormiga, indice_ult, Destinos_Posibles[i])
+                                                     : Calcular_Numerador(colonia, indice_ult, Destinos_Posibles[i]));
+            hormiga->Acumulados[i] = Denominador;
+        }
+
+        // Selecciona un destino con probabilidad proporcional a su numerador
+        Elegido = Destinos_Posibles[Seleccion_Parte(hormiga, hormiga->Acumulados, Numero_DestinosPosibles)];
+    }
+    Actualizar_Arco_Local(colonia, hormiga, indice_ult, Elegido);
+
+    hormiga->Visitado[Elegido] = true;
+    hormiga->Orden[hormiga->Numero_Visitados] = Elegido;
+    hormiga->Vehiculo_Orden[hormiga->Numero_Visitados++] = Indice_Vehiculo;
+    Vehiculo->Ultimo_Cliente = Elegido;
+    Vehiculo->Clientes_Atendidos++;
+
+    double tiempo_del_recorrido = colonia->instancia->tiempos[indice_ult * colonia->instancia->Numero_Clientes + Elegido];
+    Vehiculo->Tiempo_Consumido = Vehiculo->Tiempo_Consumido + Destinos[Elegido].Tiempo_Servicio + tiempo_del_recorrido;
+    Vehiculo->capacity_restant = Vehiculo->capacity_restant + Destinos[Elegido].Demanda;
+    return true;
+}
+
+// Función para calcular la distancia total recorrida al seguir una ruta de Longitud clientes
+static double Recorrer_Ruta_Distancia(const int *Ruta, int Longitud, const Instancia *instancia)
+{
+    double Distancia = 0.0;
+    for (int i = 0; i + 1 < Longitud; i++)
+    {
+        Distancia += instancia->distancias[Ruta[i] * instancia->Numero_Clientes + Ruta[i + 1]];
+    }
+    return Distancia;
+}
+
+// Acomoda los clientes de Orden en las rutas de la hormiga: cada vehículo ocupa un bloque contiguo de Nodos que empieza y termina
+// en el deposito, dentro del bloque los clientes quedan en el orden en que se visitaron
+static void Armar_Rutas(Hormiga *hormiga)
+{
+    hormiga->Inicio_Ruta[0] = 0;
+    for (int r = 0; r < hormiga->Numero_Rutas; r++)
+    {
+        hormiga->Inicio_Ruta[r + 1] = hormiga->Inicio_Ruta[r] + hormiga->Vehiculos[r].Clientes_Atendidos + 2;
+        hormiga->Nodos[hormiga->Inicio_Ruta[r]] = 0;
+        hormiga->Nodos[hormiga->Inicio_Ruta[r + 1] - 1] = 0;
+        hormiga->Vehiculos[r].Clientes_Atendidos = 0;
+    }
+    for (int k = 0; k < hormiga->Numero_Visitados; k++)
+    {
+        Vehicle *Vehiculo = &hormiga->Vehiculos[hormiga->Vehiculo_Orden[k]];
+        hormiga->Nodos[hormiga->Inicio_Ruta[hormiga->Vehiculo_Orden[k]] + 1 + Vehiculo->Clientes_Atendidos++] = hormiga->Orden[k];
+    }
+}
+
+// Saca del deposito el siguiente vehículo de la hormiga con el tiempo de inicio permitido, la fecha de vencimiento y la capacidad
+// restante del vehículo en relación con el depósito (Cliente [0])
+static int Abrir_Ruta(const Colonia *colonia, Hormiga *hormiga)
+{
+    const Customer *clientes = colonia->instancia->clientes;
+    int i = hormiga->Numero_Rutas++;
+    CONTAR(hormiga->Estadisticas.Rutas_Abiertas, 1);
+
+    hormiga->Vehiculos[i].number = i + 1;
+    hormiga->Vehiculos[i].capacity = colonia->instancia->Capacidad;
+    hormiga->Vehiculos[i].Tiempo_Consumido = clientes[0].Tiempo_Inicio;
+    hormiga->Vehiculos[i].Tiempo_Maximo = clientes[0].Fecha_Vencimiento;
+    hormiga->Vehiculos[i].capacity_restant = 0;
+    hormiga->Vehiculos[i].Ultimo_Cliente = 0;
+    hormiga->Vehiculos[i].Clientes_Atendidos = 0;
+    return i;
+}
+
+// Construye la solución completa de una hormiga, solo lee la instancia y las feromonas de la colonia.
+// La hormiga extiende la ruta de su vehículo actual y saca un vehículo nuevo solo cuando ningún cliente es factible, hasta
+// agotar la flota de la instancia; si aun así quedan clientes la solución no se completa
+static void Construir_Solucion(const Colonia *colonia, Hormiga *hormiga)
+{
+    int Numero_Vehiculos = colonia->instancia->Numero_Vehiculos;
+
+    hormiga->Completa = false;
+    hormiga->Distancia = 0.0;
+    hormiga->Numero_Rutas = 0;
+    hormiga->Numero_Visitados = 0;
+
+    // Ningún cliente visitado salvo el depósito
+    memset(hormiga->Visitado, 0, colonia->instancia->Numero_Clientes * sizeof(bool));
+    hormiga->Visitado[0] = true;
+
+    int Vehiculo = Abrir_Ruta(colonia, hormiga);
+    for (int i = 0; i < colonia->instancia->Numero_Clientes - 1; i++)
+    {
+        //  Cálculo de probabilidades y actualización de la ruta del vehículo actual
+        while (!Calculo_Probabilidad(colonia, hormiga, Vehiculo))
+        {
+            // Si un vehículo recién salido del deposito no puede atender a nadie, otro vehículo tampoco podrá
+            if (hormiga->Vehiculos[Vehiculo].Ultimo_Cliente == 0)
+            {
+                return;
+            }
+            // Sin vehículos en el deposito la hormiga queda incompleta: las rutas anteriores ya rechazaron a todos los clientes
+            // y ni su estado ni los clientes que faltan han cambiado desde entonces
+            if (hormiga->Numero_Rutas == Numero_Vehiculos)
+            {
+                return;
+            }
+            // El vehículo regresa al deposito
+            Actualizar_Arco_Local(colonia, hormiga, hormiga->Vehiculos[Vehiculo].Ultimo_Cliente, 0);
+            Vehiculo = Abrir_Ruta(colonia, hormiga);
+        }
+    }
+    Actualizar_Arco_Local(colonia, hormiga, hormiga->Vehiculos[Vehiculo].Ultimo_Cliente, 0);
+
+    // Cierre de cada ruta con un depósito al final y cálculo de la distancia total
+    Armar_Rutas(hormiga);
+    INICIAR_MEDICION(Inicio_Distancia);
+    hormiga->Distancia = Recorrer_Ruta_Distancia(hormiga->Nodos, hormiga->Inicio_Ruta[hormiga->Numero_Rutas], colonia->instancia);
+    TERMINAR_MEDICION(hormiga->Estadisticas.Tiempo_Distancia, Inicio_Distancia);
+    hormiga->Completa = true;
+}
+
+// Agrega al hilo los depósitos de feromona de la solución de una hormiga, Delta = 1 / distancia de la solución
+static bool Registrar_Depositos(Hilo_Construccion *Hilo, const Hormiga *hormiga)
+{
+    double Delta = 1.0 / hormiga->Distancia;
+    for (int r = 0; r < hormiga->Numero_Rutas; r++)
+    {
+        for (int i = hormiga->Inicio_Ruta[r]; i + 1 < hormiga->Inicio_Ruta[r + 1]; i++)
+        {
+            if (Hilo->Numero_Depositos == Hilo->Capacidad)
+            {
+                return false;
+            }
+            Deposito *d = &Hilo->Depositos[Hilo->Numero_Depositos++];
+            d->Origen = hormiga->Nodos[i];
+            d->Destino = hormiga->Nodos[i + 1];
+            d->Delta = Delta;
+        }
+    }
+    return true;
+}
+
+// Entradas de la tabla local de ACS de un hilo que usa a lo más Capacidad arcos por iteración: la potencia de 2 que deja al
+// menos la mitad libre
+static int Entradas_Locales(int Capacidad)
+{
+    int Entradas = 1;
+    while (Entradas < 2 * Capacidad)
+    {
+        Entradas *= 2;
+    }
+    return Entradas;
+}
+
+// AS sin búsqueda local: la solución que construye cada hormiga es la que deposita, así que cada hilo registra los depósitos de
+// sus hormigas en cuanto las construye. Con búsqueda local se registran después en Registrar_Hormigas
+static bool Depositos_En_Hilos(const Colonia *colonia)
+{
+    return colonia->Configuracion.Estrategia == ESTRATEGIA_AS && colonia->Configuracion.Hormigas_Busqueda_Local == 0;
+}
+
+// Bytes de arena que necesita un hilo en una iteración, deben coincidir con lo que reserva Hilo_Construir
+static size_t Tam_Memoria_Hilo(const Colonia *colonia, int Capacidad_Depositos)
+{
+    size_t n = colonia->instancia->Numero_Clientes;
+    size_t Tam = n * sizeof(bool) + colonia->instancia->Numero_Vehiculos * sizeof(Vehicle) + n * sizeof(int) + n * sizeof(double) +
+                 2 * n * sizeof(int) + Capacidad_Depositos * sizeof(Deposito);
+    // ACS: tabla local y lista de actualizaciones, cada hormiga actualiza a lo más los arcos de una solución completa
+    if (colonia->Configuracion.Estrategia == ESTRATEGIA_ACS)
+    {
+        Tam += Entradas_Locales(Capacidad_Depositos) * sizeof(Arco_Local) + Capacidad_Depositos * sizeof(int) + 2 * ALINEACION_ARENA;
+    }
+    // Relleno de alineación de los 7 bloques
+    return Tam + 7 * ALINEACION_ARENA;
+}
+
+// Parte de una iteración que le toca a cada hilo: construye sus hormigas contra la matriz de feromonas de la iteración
+static void Hilo_Construir(Hilo_Construccion *Hilo)
+{
+    Colonia *colonia = Hilo->colonia;
+    int n = colonia->instancia->Numero_Clientes;
+
+    // Memoria de trabajo del hilo en esta iteración, las hormigas del hilo se construyen una tras otra y la comparten
+    bool *Visitado = Arena_Reservar(&Hilo->Memoria, n * sizeof(bool));
+    Vehicle *Vehiculos = Arena_Reservar(&Hilo->Memoria, colonia->instancia->Numero_Vehiculos * sizeof(Vehicle));
+    int *Destinos_Posibles = Arena_Reservar(&Hilo->Memoria, n * sizeof(int));
+    double *Acumulados = Arena_Reservar(&Hilo->Memoria, n * sizeof(double));
+    int *Orden = Arena_Reservar(&Hilo->Memoria, n * sizeof(int));
+    int *Vehiculo_Orden = Arena_Reservar(&Hilo->Memoria, n * sizeof(int));
+    Hilo->Depositos = Arena_Reservar(&Hilo->Memoria, Hilo->Capacidad * sizeof(Deposito));
+    Hilo->Numero_Depositos = 0;
+
+    // ACS con tau0 ya fijado: tabla local vacía, todas las entradas con Arco = -1
+    Hilo->Locales = NULL;
+    Hilo->Numero_Actualizaciones = 0;
+    if (colonia->Configuracion.Estrategia == ESTRATEGIA_ACS && colonia->Feromonas_Escaladas)
+    {
+        Hilo->Locales = Arena_Reservar(&Hilo->Memoria, (Hilo->Mascara_Locales + 1) * sizeof(Arco_Local));
+        Hilo->Actualizaciones = Arena_Reservar(&Hilo->Memoria, Hilo->Capacidad * sizeof(int));
+        memset(Hilo->Locales, 0xFF, (Hilo->Mascara_Locales + 1) * sizeof(Arco_Local));
+    }
+
+    bool Registrar_En_Hilo = Depositos_En_Hilos(colonia);
+    for (int h = Hilo->Id; h < colonia->Configuracion.Numero_Hormigas; h += colonia->Numero_Hilos)
+    {
+        Hormiga *hormiga = &colonia->Hormigas[h];
+        hormiga->Visitado = Visitado;
+        hormiga->Vehiculos = Vehiculos;
+        hormiga->Destinos_Posibles = Destinos_Posibles;
+        hormiga->Acumulados = Acumulados;
+        hormiga->Orden = Orden;
+        hormiga->Vehiculo_Orden = Vehiculo_Orden;
+        hormiga->Hilo = Hilo;
+
+        Construir_Solucion(colonia, hormiga);
+        if (Registrar_En_Hilo && hormiga->Completa && !Registrar_Depositos(Hilo, hormiga))
+        {
+            // No cabe en los depósitos del hilo, la hormiga no cuenta en esta iteración
+            hormiga->Completa = false;
+        }
+    }
+}
+
+// Hilo de construcción que vive toda la ejecución: espera a que se entregue una iteración, construye sus hormigas y avisa
+// cuando termina
+static void *Hilo_Trabajador(void *Argumento)
+{
+    Hilo_Construccion *Hilo = Argumento;
+    Colonia *colonia = Hilo->colonia;
+    unsigned long Construida = 0;
+
+    pthread_mutex_lock(&colonia->Candado);
+    for (;;)
+    {
+        while (colonia->Generacion == Construida && !colonia->Terminar)
+        {
+            pthread_cond_wait(&colonia->Hay_Trabajo, &colonia->Candado);
+        }
+        if (colonia->Terminar)
+        {
+            break;
+        }
+        Construida = colonia->Generacion;
+        pthread_mutex_unlock(&colonia->Candado);
+
+        Hilo_Construir(Hilo);
+
+        pthread_mutex_lock(&colonia->Candado);
+        if (--colonia->Pendientes == 0)
+        {
+            pthread_cond_signal(&colonia->Trabajo_Terminado);
+        }
+    }
+    pthread_mutex_unlock(&colonia->Candado);
+    return NULL;
+}
+
+// Crea una sola vez los hilos 1..Numero_Hilos - 1 de la colonia. Si alguno no se puede crear ya no se intentan los demás y el
+// hilo que llama construye también sus hormigas
+static void Lanzar_Hilos(Colonia *colonia)
+{
+    if (colonia->Numero_Hilos <= 1)
+    {
+        return;
+    }
+    colonia->Trabajadores = malloc((colonia->Numero_Hilos - 1) * sizeof(pthread_t));
+    if (colonia->Trabajadores == NULL)
+    {
+        return;
+    }
+    pthread_mutex_init(&colonia->Candado, NULL);
+    pthread_cond_init(&colonia->Hay_Trabajo, NULL);
+    pthread_cond_init(&colonia->Trabajo_Terminado, NULL);
+    colonia->Generacion = 0;
+    colonia->Pendientes = 0;
+    colonia->Terminar = false;
+    for (int t = 1; t < colonia->Numero_Hilos; t++)
+    {
+        if (pthread_create(&colonia->Trabajadores[t - 1], NULL, Hilo_Trabajador, &colonia->Hilos[t]) != 0)
+        {
+            break;
+        }
+        colonia->Hilos_Lanzados = t;
+    }
+}
+
+// Pide a los hilos que terminen y los espera
+static void Detener_Hilos(Colonia *colonia)
+{
+    if (colonia->Trabajadores == NULL)
+    {
+        return;
+    }
+    pthread_mutex_lock(&colonia->Candado);
+    colonia->Terminar = true;
+    pthread_cond_broadcast(&colonia->Hay_Trabajo);
+    pthread_mutex_unlock(&colonia->Candado);
+    for (int t = 0; t < colonia->Hilos_Lanzados; t++)
+    {
+        pthread_join(colonia->Trabajadores[t], NULL);
+    }
+    pthread_mutex_destroy(&colonia->Candado);
+    pthread_cond_destroy(&colonia->Hay_Trabajo);
+    pthread_cond_destroy(&colonia->Trabajo_Terminado);
+    free(colonia->Trabajadores);
+    colonia->Trabajadores = NULL;
+    colonia->Hilos_Lanzados = 0;
+}
+
+// Construye las soluciones de todas las hormigas repartidas entre los hilos de la colonia. El hilo 0 es el que llama y también
+// construye las hormigas de los hilos que no se lanzaron
+static void Construir_Hormigas(Colonia *colonia)
+{
+    if (colonia->Hilos_Lanzados > 0)
+    {
+        pthread_mutex_lock(&colonia->Candado);
+        colonia->Generacion++;
+        colonia->Pendientes = colonia->Hilos_Lanzados;
+        pthread_cond_broadcast(&colonia->Hay_Trabajo);
+        pthread_mutex_unlock(&colonia->Candado);
+    }
+    Hilo_Construir(&colonia->Hilos[0]);
+    for (int t = colonia->Hilos_Lanzados + 1; t < colonia->Numero_Hilos; t++)
+    {
+        Hilo_Construir(&colonia->Hilos[t]);
+    }
+    if (colonia->Hilos_Lanzados > 0)
+    {
+        pthread_mutex_lock(&colonia->Candado);
+        while (colonia->Pendientes > 0)
+        {
+            pthread_cond_wait(&colonia->Trabajo_Terminado, &colonia->Candado);
+        }
+        pthread_mutex_unlock(&colonia->Candado);
+    }
+}
+
+// Búsqueda local: mejora la solución completa de una hormiga con movimientos entre dos rutas (relocalizar una cadena de 1 a
+// CADENA_MAXIMA clientes, intercambiar dos clientes y 2-opt*, que intercambia los finales de las rutas) y dentro de una ruta
+// (Or-opt, mover una cadena a otra posición de su ruta). Entre rutas solo se prueban los movimientos que dejan a un cliente junto a
+// uno de sus candidatos. Se aplica el primer movimiento que reduce la distancia y se repite hasta que ninguno mejora
+
+// Clientes de la cadena más larga que mueven relocalizar y Or-opt
+#define CADENA_MAXIMA 3
+
+// Margen con el que se revisan las ventanas de tiempo en O(1). Los tiempos de un movimiento se suman en otro orden que al recorrer
+// la ruta, así que un movimiento justo en el borde de una ventana se rechaza en lugar de arriesgar una ruta infactible
+#define HOLGURA_VENTANA 1e-7
+
+// Reducción mínima de la distancia para aplicar un movimiento, evita ciclos por redondeo
+#define MEJORA_MINIMA 1e-9
+
+// Tramo de ruta visto como un bloque: ventana de llegada a su primer nodo con la que todo el tramo es factible, tiempo desde esa
+// llegada hasta la salida de su último nodo y carga total. Un sufijo de ruta es un tramo cuya duración no importa
+typedef struct
+{
+    int Primero;           // Primer nodo del tramo
+    int Ultimo;            // Último nodo del tramo
+    double Llegada_Minima; // Llegada más temprana al primer nodo
+    double Llegada_Maxima; // Llegada más tardía al primer nodo
+    double Duracion;       // De la llegada al primer nodo a la salida del último
+    int Carga;             // Demanda de los clientes del tramo
+} Tramo;
+
+// Ruta que se arma pieza por pieza para revisar un movimiento: último nodo, su tiempo de salida y la carga hasta él
+typedef struct
+{
+    int Nodo;
+    double Salida;
+    int Carga;
+} Recorrido;
+
+// Cliente de la instancia que representa un nodo de la búsqueda local, los depositos de las rutas son el cliente 0
+static int Cliente_Nodo(const Instancia *instancia, int Nodo)
+{
+    return Nodo < instancia->Numero_Clientes ? Nodo : 0;
+}
+
+static double Distancia_Nodos(const Instancia *instancia, int Origen, int Destino)
+{
+    return instancia->distancias[Cliente_Nodo(instancia, Origen) * instancia->Numero_Clientes + Cliente_Nodo(instancia, Destino)];
+}
+
+static double Tiempo_Nodos(const Instancia *instancia, int Origen, int Destino)
+{
+    return instancia->tiempos[Cliente_Nodo(instancia, Origen) * instancia->Numero_Clientes + Cliente_Nodo(instancia, Destino)];
+}
+
+// Tramo de un solo cliente
+static Tramo Tramo_Cliente(const Instancia *instancia, int Cliente)
+{
+    const Customer *c = &instancia->clientes[Cliente];
+    Tramo t = {Cliente, Cliente, c->Tiempo_Inicio, c->Fecha_Vencimiento, c->Tiempo_Servicio, c->Demanda};
+    return t;
+}
+
+// Resto de la ruta desde un nodo hasta su deposito de llegada
+static Tramo Tramo_Sufijo(const Busqueda_Local *bl, int Nodo)
+{
+    Tramo t = {Nodo, Nodo, bl->Llegada_Minima[Nodo], bl->Llegada_Maxima[Nodo], 0.0, bl->Carga_Sufijo[Nodo]};
+    return t;
+}
+
+// Tramo A seguido del tramo B: la ventana de B se traslada a la llegada al primer nodo de A
+static Tramo Unir_Tramos(const Instancia *instancia, const Tramo *A, const Tramo *B)
+{
+    double Desfase = A->Duracion + Tiempo_Nodos(instancia, A->Ultimo, B->Primero);
+    Tramo t = {A->Primero, B->Ultimo, fmax(A->Llegada_Minima, B->Llegada_Minima - Desfase),
+               fmin(A->Llegada_Maxima, B->Llegada_Maxima - Desfase), Desfase + B->Duracion, A->Carga + B->Carga};
+    return t;
+}
+
+// Inicio de una ruta hasta el nodo dado, tal como está
+static Recorrido Recorrido_Prefijo(const Busqueda_Local *bl, int Nodo)
+{
+    Recorrido r = {Nodo, bl->Salida[Nodo], bl->Carga_Prefijo[Nodo]};
+    return r;
+}
+
+// Agrega un tramo después del recorrido, false si se llega fuera de la ventana del tramo o se excede la capacidad
+static bool Agregar_Tramo(const Instancia *instancia, Recorrido *r, const Tramo *t)
+{
+    double Llegada = r->Salida + Tiempo_Nodos(instancia, r->Nodo, t->Primero);
+    if (Llegada < t->Llegada_Minima + HOLGURA_VENTANA || Llegada > t->Llegada_Maxima - HOLGURA_VENTANA)
+    {
+        return false;
+    }
+    r->Nodo = t->Ultimo;
+    r->Salida = Llegada + t->Duracion;
+    r->Carga += t->Carga;
+    return r->Carga <= instancia->Capacidad;
+}
+
+// Ruta formada por el inicio de una ruta hasta Nodo y luego los tramos dados, en O(Numero_Tramos)
+static bool Ruta_Armada_Factible(const Busqueda_Local *bl, const Instancia *instancia, int Nodo, const Tramo *Tramos, int Numero_Tramos)
+{
+    Recorrido r = Recorrido_Prefijo(bl, Nodo);
+    for (int i = 0; i < Numero_Tramos; i++)
+    {
+        if (!Agregar_Tramo(instancia, &r, &Tramos[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Recalcula los tiempos, cargas y ventanas de los nodos de una ruta después de cambiarla, en O(longitud de la ruta)
+static void Actualizar_Ruta(Busqueda_Local *bl, const Instancia *instancia, int Ruta)
+{
+    int n = instancia->Numero_Clientes;
+    const Customer *clientes = instancia->clientes;
+
+    // Hacia adelante desde el deposito de salida: tiempo de salida y carga acumulada
+    int Nodo = n + 2 * Ruta;
+    bl->Ruta[Nodo] = Ruta;
+    bl->Salida[Nodo] = clientes[0].Tiempo_Inicio;
+    bl->Carga_Prefijo[Nodo] = 0;
+    do
+    {
+        int Siguiente = bl->Siguiente[Nodo];
+        const Customer *Cliente = &clientes[Cliente_Nodo(instancia, Siguiente)];
+        bl->Ruta[Siguiente] = Ruta;
+        bl->Pendiente[Siguiente] = true;
+        bl->Salida[Siguiente] = bl->Salida[Nodo] + Tiempo_Nodos(instancia, Nodo, Siguiente) + Cliente->Tiempo_Servicio;
+        bl->Carga_Prefijo[Siguiente] = bl->Carga_Prefijo[Nodo] + Cliente->Demanda;
+        Nodo = Siguiente;
+    } while (Nodo < n);
+
+    // Hacia atrás desde el deposito de llegada, que no tiene ventana: ventana de llegada y carga que falta
+    bl->Llegada_Minima[Nodo] = -INFINITY;
+    bl->Llegada_Maxima[Nodo] = INFINITY;
+    bl->Carga_Sufijo[Nodo] = 0;
+    for (int Anterior = bl->Anterior[Nodo]; Anterior < n; Nodo = Anterior, Anterior = bl->Anterior[Nodo])
+    {
+        double Desfase = clientes[Anterior].Tiempo_Servicio + Tiempo_Nodos(instancia, Anterior, Nodo);
+        bl->Llegada_Minima[Anterior] = fmax(clientes[Anterior].Tiempo_Inicio, bl->Llegada_Minima[Nodo] - Desfase);
+        bl->Llegada_Maxima[Anterior] = fmin(clientes[Anterior].Fecha_Vencimiento, bl->Llegada_Maxima[Nodo] - Desfase);
+        bl->Carga_Sufijo[Anterior] = bl->Carga_Sufijo[Nodo] + clientes[Anterior].Demanda;
+    }
+}
+
+// Saca la cadena Primero..Ultimo de su ruta y la pone después de Nodo, que no puede estar en la cadena
+static void Mover_Cadena(Busqueda_Local *bl, int Primero, int Ultimo, int Nodo)
+{
+    int Antes = bl->Anterior[Primero];
+    int Despues = bl->Siguiente[Ultimo];
+    bl->Siguiente[Antes] = Despues;
+    bl->Anterior[Despues] = Antes;
+
+    int Siguiente = bl->Siguiente[Nodo];
+    bl->Siguiente[Nodo] = Primero;
+    bl->Anterior[Primero] = Nodo;
+    bl->Siguiente[Ultimo] = Siguiente;
+    bl->Anterior[Siguiente] = Ultimo;
+}
+
+// Intercambia dos clientes de rutas distintas
+static void Intercambiar_Clientes(Busqueda_Local *bl, int u, int v)
+{
+    int pu = bl->Anterior[u], nu = bl->Siguiente[u];
+    int pv = bl->Anterior[v], nv = bl->Siguiente[v];
+    bl->Siguiente[pu] = v;
+    bl->Anterior[v] = pu;
+    bl->Siguiente[v] = nu;
+    bl->Anterior[nu] = v;
+    bl->Siguiente[pv] = u;
+    bl->Anterior[u] = pv;
+    bl->Siguiente[u] = nv;
+    bl->Anterior[nv] = u;
+}
+
+// 2-opt*: la ruta de u sigue después de u con el final de la ruta de v desde v, y la de v sigue antes de v con el final de la de u
+static void Cruzar_Rutas(Busqueda_Local *bl, int u, int v)
+{
+    int nu = bl->Siguiente[u];
+    int pv = bl->Anterior[v];
+    bl->Siguiente[u] = v;
+    bl->Anterior[v] = u;
+    bl->Siguiente[pv] = nu;
+    bl->Anterior[nu] = pv;
+}
+
+// Prueba los movimientos entre la ruta de u y la de su candidato v y aplica el primero que mejora. Devuelve la mejora, 0 si no hubo
+static double Mejorar_Entre_Rutas(Busqueda_Local *bl, const Instancia *instancia, int u, int v)
+{
+    int n = instancia->Numero_Clientes;
+    int Ruta_u = bl->Ruta[u], Ruta_v = bl->Ruta[v];
+    int pu = bl->Anterior[u], nu = bl->Siguiente[u];
+    int pv = bl->Anterior[v], nv = bl->Siguiente[v];
+
+    // Relocalizar la cadena que empieza en u después o antes de v
+    Tramo Cadena = Tramo_Cliente(instancia, u);
+    for (int w = u, Longitud = 1; Longitud <= CADENA_MAXIMA; Longitud++)
+    {
+        if (Longitud > 1)
+        {
+            w = bl->Siguiente[w];
+            if (w >= n)
+            {
+                break;
+            }
+            Tramo Cliente = Tramo_Cliente(instancia, w);
+            Cadena = Unir_Tramos(instancia, &Cadena, &Cliente);
+        }
+        int nw = bl->Siguiente[w];
+        double Quitar = Distancia_Nodos(instancia, pu, nw) - Distancia_Nodos(instancia, pu, u) - Distancia_Nodos(instancia, w, nw);
+        double Despues = Quitar + Distancia_Nodos(instancia, v, u) + Distancia_Nodos(instancia, w, nv) - Distancia_Nodos(instancia, v, nv);
+        double Antes = Quitar + Distancia_Nodos(instancia, pv, u) + Distancia_Nodos(instancia, w, v) - Distancia_Nodos(instancia, pv, v);
+        CONTAR(bl->Estadisticas.Movimientos_Evaluados, 2);
+        if (!(Despues < -MEJORA_MINIMA || Antes < -MEJORA_MINIMA))
+        {
+            continue;
+        }
+        Tramo Resto = Tramo_Sufijo(bl, nw);
+        if (!Ruta_Armada_Factible(bl, instancia, pu, &Resto, 1))
+        {
+            continue;
+        }
+        Tramo Despues_v[2] = {Cadena, Tramo_Sufijo(bl, nv)};
+        if (Despues < -MEJORA_MINIMA && Ruta_Armada_Factible(bl, instancia, v, Despues_v, 2))
+        {
+            Mover_Cadena(bl, u, w, v);
+            Actualizar_Ruta(bl, instancia, Ruta_u);
+            Actualizar_Ruta(bl, instancia, Ruta_v);
+            return -Despues;
+        }
+        Tramo Antes_v[2] = {Cadena, Tramo_Sufijo(bl, v)};
+        if (Antes < -MEJORA_MINIMA && Ruta_Armada_Factible(bl, instancia, pv, Antes_v, 2))
+        {
+            Mover_Cadena(bl, u, w, pv);
+            Actualizar_Ruta(bl, instancia, Ruta_u);
+            Actualizar_Ruta(bl, instancia, Ruta_v);
+            return -Antes;
+        }
+    }
+
+    // Intercambiar u y v
+    double Intercambio = Distancia_Nodos(instancia, pu, v) + Distancia_Nodos(instancia, v, nu) - Distancia_Nodos(instancia, pu, u) -
+                         Distancia_Nodos(instancia, u, nu) + Distancia_Nodos(instancia, pv, u) + Distancia_Nodos(instancia, u, nv) -
+                         Distancia_Nodos(instancia, pv, v) - Distancia_Nodos(instancia, v, nv);
+    CONTAR(bl->Estadisticas.Movimientos_Evaluados, 1);
+    if (Intercambio < -MEJORA_MINIMA)
+    {
+        Tramo Ruta_u_Nueva[2] = {Tramo_Cliente(instancia, v), Tramo_Sufijo(bl, nu)};
+        Tramo Ruta_v_Nueva[2] = {Tramo_Cliente(instancia, u), Tramo_Sufijo(bl, nv)};
+        if (Ruta_Armada_Factible(bl, instancia, pu, Ruta_u_Nueva, 2) && Ruta_Armada_Factible(bl, instancia, pv, Ruta_v_Nueva, 2))
+        {
+            Intercambiar_Clientes(bl, u, v);
+            Actualizar_Ruta(bl, instancia, Ruta_u);
+            Actualizar_Ruta(bl, instancia, Ruta_v);
+            return -Intercambio;
+        }
+    }
+
+    // 2-opt*: u seguido de v, o v seguido de u
+    double Cruce_uv = Distancia_Nodos(instancia, u, v) + Distancia_Nodos(instancia, pv, nu) - Distancia_Nodos(instancia, u, nu) -
+                      Distancia_Nodos(instancia, pv, v);
+    double Cruce_vu = Distancia_Nodos(instancia, v, u) + Distancia_Nodos(instancia, pu, nv) - Distancia_Nodos(instancia, v, nv) -
+                      Distancia_Nodos(instancia, pu, u);
+    CONTAR(bl->Estadisticas.Movimientos_Evaluados, 2);
+    Tramo Desde_v = Tramo_Sufijo(bl, v), Desde_nu = Tramo_Sufijo(bl, nu);
+    if (Cruce_uv < -MEJORA_MINIMA && Ruta_Armada_Factible(bl, instancia, u, &Desde_v, 1) &&
+        Ruta_Armada_Factible(bl, instancia, pv, &Desde_nu, 1))
+    {
+        Cruzar_Rutas(bl, u, v);
+        Actualizar_Ruta(bl, instancia, Ruta_u);
+        Actualizar_Ruta(bl, instancia, Ruta_v);
+        return -Cruce_uv;
+    }
+    Tramo Desde_u = Tramo_Sufijo(bl, u), Desde_nv = Tramo_Sufijo(bl, nv);
+    if (Cruce_vu < -MEJORA_MINIMA && Ruta_Armada_Factible(bl, instancia, v, &Desde_u, 1) &&
+        Ruta_Armada_Factible(bl, instancia, pu, &Desde_nv, 1))
+    {
+        Cruzar_Rutas(bl, v, u);
+        Actualizar_Ruta(bl, instancia, Ruta_u);
+        Actualizar_Ruta(bl, instancia, Ruta_v);
+        return -Cruce_vu;
+    }
+    return 0.0;
+}
+
+// Or-opt: mueve la cadena que empieza en u a otra posición de su misma ruta. Los clientes entre la posición vieja y la nueva forman
+// un tramo que crece un cliente a la vez, así cada posición se revisa en O(1); si ese tramo ya es infactible se deja de buscar
+// en esa dirección. Devuelve la mejora, 0 si no hubo
+static double Mejorar_Dentro_Ruta(Busqueda_Local *bl, const Instancia *instancia, int u)
+{
+    int n = instancia->Numero_Clientes;
+    int Ruta = bl->Ruta[u];
+    int pu = bl->Anterior[u];
+
+    Tramo Cadena = Tramo_Cliente(instancia, u);
+    for (int w = u, Longitud = 1; Longitud <= CADENA_MAXIMA; Longitud++)
+    {
+        if (Longitud > 1)
+        {
+            w = bl->Siguiente[w];
+            if (w >= n)
+            {
+                break;
+            }
+            Tramo Cliente = Tramo_Cliente(instancia, w);
+            Cadena = Unir_Tramos(instancia, &Cadena, &Cliente);
+        }
+        int nw = bl->Siguiente[w];
+        double Quitar = Distancia_Nodos(instancia, pu, nw) - Distancia_Nodos(instancia, pu, u) - Distancia_Nodos(instancia, w, nw);
+
+        // Hacia adelante: la cadena va después de j, entre la posición vieja y j quedan los clientes nw..j
+        if (nw < n)
+        {
+            Tramo Medio = Tramo_Cliente(instancia, nw);
+            for (int j = nw; j < n; j = bl->Siguiente[j])
+            {
+                int nj = bl->Siguiente[j];
+                double Delta = Quitar + Distancia_Nodos(instancia, j, u) + Distancia_Nodos(instancia, w, nj) - Distancia_Nodos(instancia, j, nj);
+                CONTAR(bl->Estadisticas.Movimientos_Evaluados, 1);
+                Tramo Tramos[3] = {Medio, Cadena, Tramo_Sufijo(bl, nj)};
+                if (Delta < -MEJORA_MINIMA && Ruta_Armada_Factible(bl, instancia, pu, Tramos, 3))
+                {
+                    Mover_Cadena(bl, u, w, j);
+                    Actualizar_Ruta(bl, instancia, Ruta);
+                    return -Delta;
+                }
+                if (nj >= n)
+                {
+                    break;
+                }
+                Tramo Cliente = Tramo_Cliente(instancia, nj);
+                Medio = Unir_Tramos(instancia, &Medio, &Cliente);
+                if (Medio.Llegada_Minima > Medio.Llegada_Maxima)
+                {
+                    break;
+                }
+            }
+        }
+
+        // Hacia atrás: la cadena va después de j, entre j y la posición vieja quedan los clientes siguiente(j)..pu
+        if (pu < n)
+        {
+            Tramo Medio = Tramo_Cliente(instancia, pu);
+            for (int j = bl->Anterior[pu];; j = bl->Anterior[j])
+            {
+                int nj = bl->Siguiente[j];
+                double Delta = Quitar + Distancia_Nodos(instancia, j, u) + Distancia_Nodos(instancia, w, nj) - Distancia_Nodos(instancia, j, nj);
+                CONTAR(bl->Estadisticas.Movimientos_Evaluados, 1);
+                Tramo Tramos[3] = {Cadena, Medio, Tramo_Sufijo(bl, nw)};
+                if (Delta < -MEJORA_MINIMA && Ruta_Armada_Factible(bl, instancia, j, Tramos, 3))
+                {
+                    Mover_Cadena(bl, u, w, j);
+                    Actualizar_Ruta(bl, instancia, Ruta);
+                    return -Delta;
+                }
+                if (j >= n)
+                {
+                    break;
+                }
+                Tramo Cliente = Tramo_Cliente(instancia, j);
+                Medio = Unir_Tramos(instancia, &Cliente, &Medio);
+                if (Medio.Llegada_Minima > Medio.Llegada_Maxima)
+                {
+                    break;
+                }
+            }
+        }
+    }
+    return 0.0;
+}
+
+// Recorre una ruta de las listas igual que la construcción, sin holgura, para confirmar que es factible
+static bool Ruta_Factible(const Busqueda_Local *bl, const Instancia *instancia, int Ruta)
+{
+    int n = instancia->Numero_Clientes;
+    const Customer *clientes = instancia->clientes;
+    double Tiempo_Consumido = clientes[0].Tiempo_Inicio;
+    int Carga = 0;
+    int Anterior = n + 2 * Ruta;
+    for (int Nodo = bl->Siguiente[Anterior]; Nodo < n; Anterior = Nodo, Nodo = bl->Siguiente[Nodo])
+    {
+        double tiempo_del_recorrido = Tiempo_Nodos(instancia, Anterior, Nodo);
+        if (Tiempo_Consumido + tiempo_del_recorrido < clientes[Nodo].Tiempo_Inicio ||
+            Tiempo_Consumido + tiempo_del_recorrido > clientes[Nodo].Fecha_Vencimiento)
+        {
+            return false;
+        }
+        Tiempo_Consumido = Tiempo_Consumido + clientes[Nodo].Tiempo_Servicio + tiempo_del_recorrido;
+        Carga += clientes[Nodo].Demanda;
+    }
+    return Carga <= instancia->Capacidad;
+}
+
+// Aplica la búsqueda local a la solución completa de una hormiga. Si la mejora, reescribe sus rutas (sin las que quedaron vacías)
+// y su distancia
+static void Mejorar_Hormiga(Busqueda_Local *bl, const Instancia *instancia, Hormiga *hormiga)
+{
+    int n = instancia->Numero_Clientes;
+
+    // Rutas de la hormiga a listas, los depositos de cada ruta se cambian por los suyos
+    bl->Numero_Rutas = hormiga->Numero_Rutas;
+    for (int r = 0; r < hormiga->Numero_Rutas; r++)
+    {
+        int Anterior = n + 2 * r;
+        for (int i = hormiga->Inicio_Ruta[r] + 1; i < hormiga->Inicio_Ruta[r + 1]; i++)
+        {
+            int Nodo = i + 1 < hormiga->Inicio_Ruta[r + 1] ? hormiga->Nodos[i] : n + 2 * r + 1;
+            bl->Siguiente[Anterior] = Nodo;
+            bl->Anterior[Nodo] = Anterior;
+            Anterior = Nodo;
+        }
+        Actualizar_Ruta(bl, instancia, r);
+    }
+
+    // Se recorren los clientes en orden hasta una vuelta completa sin mejoras
+    double Mejora_Total = 0.0;
+    const int k = instancia->Numero_Candidatos;
+    for (bool Mejoro = true; Mejoro;)
+    {
+        Mejoro = false;
+        for (int u = 1; u < n; u++)
+        {
+            if (!bl->Pendiente[u])
+            {
+                continue;
+            }
+            bl->Pendiente[u] = false;
+            double Mejora = 0.0;
+            const int *Candidatos = &instancia->candidatos[u * k];
+            for (int c = 0; c < k && Mejora == 0.0; c++)
+            {
+                if (bl->Ruta[Candidatos[c]] != bl->Ruta[u])
+                {
+                    Mejora = Mejorar_Entre_Rutas(bl, instancia, u, Candidatos[c]);
+                }
+            }
+            if (Mejora == 0.0)
+            {
+                Mejora = Mejorar_Dentro_Ruta(bl, instancia, u);
+            }
+            if (Mejora > 0.0)
+            {
+                CONTAR(bl->Estadisticas.Movimientos_Aplicados, 1);
+                Mejora_Total += Mejora;
+                Mejoro = true;
+            }
+        }
+    }
+    if (Mejora_Total == 0.0)
+    {
+        return;
+    }
+
+    // Las ventanas se revisaron con holgura, de todos modos cada ruta se confirma antes de reemplazar la solución de la hormiga
+    for (int r = 0; r < bl->Numero_Rutas; r++)
+    {
+        if (!Ruta_Factible(bl, instancia, r))
+        {
+            return;
+        }
+    }
+
+    int Numero_Rutas = 0;
+    int Total_Nodos = 0;
+    hormiga->Inicio_Ruta[0] = 0;
+    for (int r = 0; r < bl->Numero_Rutas; r++)
+    {
+        if (bl->Siguiente[n + 2 * r] >= n)
+        {
+            continue; // La ruta se quedó sin clientes, ese vehículo ya no sale
+        }
+        hormiga->Nodos[Total_Nodos++] = 0;
+        for (int Nodo = bl->Siguiente[n + 2 * r]; Nodo < n; Nodo = bl->Siguiente[Nodo])
+        {
+            hormiga->Nodos[Total_Nodos++] = Nodo;
+        }
+        hormiga->Nodos[Total_Nodos++] = 0;
+        hormiga->Inicio_Ruta[++Numero_Rutas] = Total_Nodos;
+    }
+    hormiga->Numero_Rutas = Numero_Rutas;
+    hormiga->Distancia = Recorrer_Ruta_Distancia(hormiga->Nodos, Total_Nodos, instancia);
+}
+
+// Aplica la búsqueda local a las Hormigas_Busqueda_Local hormigas completas con menor distancia de la iteración
+static void Mejorar_Mejores_Hormigas(Colonia *colonia)
+{
+    int num_hormigas = colonia->Configuracion.Numero_Hormigas;
+    int Elegidas[num_hormigas];
+    int Numero_Elegidas = 0;
+
+    // Selección de las mejores antes de mejorar ninguna, en empate gana la de menor índice
+    bool Elegida[num_hormigas];
+    memset(Elegida, 0, sizeof(Elegida));
+    while (Numero_Elegidas < colonia->Configuracion.Hormigas_Busqueda_Local)
+    {
+        int Mejor = -1;
+        for (int h = 0; h < num_hormigas; h++)
+        {
+            const Hormiga *hormiga = &colonia->Hormigas[h];
+            if (hormiga->Completa && !Elegida[h] && (Mejor < 0 || hormiga->Distancia < colonia->Hormigas[Mejor].Distancia))
+            {
+                Mejor = h;
+            }
+        }
+        if (Mejor < 0)
+        {
+            break;
+        }
+        Elegida[Mejor] = true;
+        Elegidas[Numero_Elegidas++] = Mejor;
+    }
+
+    for (int i = 0; i < Numero_Elegidas; i++)
+    {
+        Mejorar_Hormiga(&colonia->Mejora, colonia->instancia, &colonia->Hormigas[Elegidas[i]]);
+    }
+}
+
+// Registra los depósitos de las hormigas completas en el hilo que las construyó y en el orden en que las construyó. Se usa solo
+// con búsqueda local: las mejores hormigas se eligen entre todas las de la iteración y se mejoran en el hilo principal después
+// de la construcción, así que sus rutas (y sus depósitos) no existen hasta entonces. Los depósitos siguen separados por hilo y
+// se suman igual que los que registran los hilos sin búsqueda local
+static void Registrar_Hormigas(Colonia *colonia)
+{
+    for (int t = 0; t < colonia->Numero_Hilos; t++)
+    {
+        Hilo_Construccion *Hilo = &colonia->Hilos[t];
+        for (int h = t; h < colonia->Configuracion.Numero_Hormigas; h += colonia->Numero_Hilos)
+        {
+            Hormiga *hormiga = &colonia->Hormigas[h];
+            if (hormiga->Completa && !Registrar_Depositos(Hilo, hormiga))
+            {
+                // No cabe en los depósitos del hilo, la hormiga no cuenta en esta iteración
+                hormiga->Completa = false;
+            }
+        }
+    }
+}
+
+// Bytes de arena de la búsqueda local: cinco arreglos de enteros, tres de double y uno de bool, uno por nodo
+static size_t Tam_Memoria_Busqueda(const Instancia *instancia)
+{
+    size_t Nodos = instancia->Numero_Clientes + 2 * (size_t)instancia->Numero_Vehiculos;
+    return Nodos * (5 * sizeof(int) + 3 * sizeof(double) + sizeof(bool)) + 9 * ALINEACION_ARENA;
+}
+
+// Reserva los arreglos de la búsqueda local, se usan en todas las iteraciones
+static bool Crear_Busqueda_Local(Busqueda_Local *bl, const Instancia *instancia)
+{
+    size_t Nodos = instancia->Numero_Clientes + 2 * (size_t)instancia->Numero_Vehiculos;
+    if (!Crear_Arena(&bl->Memoria, Tam_Memoria_Busqueda(instancia)))
+    {
+        return false;
+    }
+    bl->Siguiente = Arena_Reservar(&bl->Memoria, Nodos * sizeof(int));
+    bl->Anterior = Arena_Reservar(&bl->Memoria, Nodos * sizeof(int));
+    bl->Ruta = Arena_Reservar(&bl->Memoria, Nodos * sizeof(int));
+    bl->Carga_Prefijo = Arena_Reservar(&bl->Memoria, Nodos * sizeof(int));
+    bl->Carga_Sufijo = Arena_Reservar(&bl->Memoria, Nodos * sizeof(int));
+    bl->Salida = Arena_Reservar(&bl->Memoria, Nodos * sizeof(double));
+    bl->Llegada_Minima = Arena_Reservar(&bl->Memoria, Nodos * sizeof(double));
+    bl->Llegada_Maxima = Arena_Reservar(&bl->Memoria, Nodos * sizeof(double));
+    bl->Pendiente = Arena_Reservar(&bl->Memoria, Nodos * sizeof(bool));
+    return true;
+}
+
+// Función para actualizar la matriz de feromonas: evapora y suma los depósitos acumulados por cada hilo. Solo toca los arcos
+// con depósito, la evaporación queda en la escala
+static void Actualizar_Feromonas(Colonia *colonia)
+{
+    int n = colonia->instancia->Numero_Clientes;
+    Evaporar_Feromonas(colonia, 0.0);
+
+    // Los hilos se suman siempre en el mismo orden para que la ejecución sea reproducible
+    double Inversa_Escala = 1.0 / colonia->Escala_Feromonas;
+    for (int t = 0; t < colonia->Numero_Hilos; t++)
+    {
+        const Hilo_Construccion *Hilo = &colonia->Hilos[t];
+        for (int d = 0; d < Hilo->Numero_Depositos; d++)
+        {
+            colonia->feromonas[Hilo->Depositos[d].Origen * n + Hilo->Depositos[d].Destino] += Hilo->Depositos[d].Delta * Inversa_Escala;
+        }
+    }
+    colonia->feromonas[0] = 0.0; // Las rutas vacías depositan en la diagonal, que debe ser cero
+}
+
+// Suma Delta a la feromona de cada arco de una solución sin pasar de Maximo
+static void Depositar_Rutas(Colonia *colonia, const int *Nodos, const int *Inicio_Ruta, int Numero_Rutas, double Delta, double Maximo)
+{
+    int n = colonia->instancia->Numero_Clientes;
+    for (int r = 0; r < Numero_Rutas; r++)
+    {
+        for (int i = Inicio_Ruta[r]; i + 1 < Inicio_Ruta[r + 1]; i++)
+        {
+            int Arco = Nodos[i] * n + Nodos[i + 1];
+            Fijar_Feromona_Arco(colonia, Arco, fmin(Feromona_Arco(colonia, Arco) + Delta, Maximo));
+        }
+    }
+}
+
+// Acerca la feromona de un arco a Valor: tau = (1 - Peso) * tau + Peso * Valor, y recalcula su numerador
+static void Mezclar_Arco(Colonia *colonia, int Origen, int Destino, double Peso, double Valor)
+{
+    int Arco = Origen * colonia->instancia->Numero_Clientes + Destino;
+    Fijar_Feromona_Arco(colonia, Arco, (1 - Peso) * Feromona_Arco(colonia, Arco) + Peso * Valor);
+    Actualizar_Atractivo_Arco(colonia, Origen, Destino);
+}
+
+// Mezcla con Valor cada arco de una solución
+static void Mezclar_Rutas(Colonia *colonia, const int *Nodos, const int *Inicio_Ruta, int Numero_Rutas, double Peso, double Valor)
+{
+    for (int r = 0; r < Numero_Rutas; r++)
+    {
+        for (int i = Inicio_Ruta[r]; i + 1 < Inicio_Ruta[r + 1]; i++)
+        {
+            Mezclar_Arco(colonia, Nodos[i], Nodos[i + 1], Peso, Valor);
+        }
+    }
+}
+
+// MAX-MIN Ant System: evapora toda la matriz y solo deposita la mejor solución de la iteración (la mejor global cada
+// MMAS_CADA_MEJOR_GLOBAL iteraciones), con las feromonas entre tau_min y tau_max. tau_max = 1 / (Rho * mejor distancia) crece
+// conforme mejora la mejor solución y tau_min = tau_max / (2 * Numero_Clientes). Si la mejor solución no mejora en
+// Reinicio_Estancamiento iteraciones todas las feromonas vuelven a tau_max. Devuelve true si reinició
+static bool Actualizar_Feromonas_MMAS(Colonia *colonia, const Hormiga *Mejor_Hormiga, const Resultado_Colonia *Mejor, int Iteracion)
+{
+    if (!isfinite(Mejor->Mejor_Distancia))
+    {
+        return false; // Sin ninguna solución completa todavía las feromonas siguen uniformes
+    }
+    int n = colonia->instancia->Numero_Clientes;
+    double Maximo = 1.0 / (colonia->Configuracion.Rho * Mejor->Mejor_Distancia);
+    double Minimo = Maximo / (2.0 * n);
+
+    // La primera solución completa fija la escala: todas las feromonas empiezan en tau_max
+    int Reinicio = colonia->Configuracion.Reinicio_Estancamiento;
+    if (!colonia->Feromonas_Escaladas || (Reinicio > 0 && colonia->Iteraciones_Sin_Mejora >= Reinicio))
+    {
+        bool Reinicio_Estancamiento = colonia->Feromonas_Escaladas;
+        inicializar_feromonas(colonia, Maximo);
+        colonia->Feromona_Inicial = Maximo;
+        colonia->Feromonas_Escaladas = true;
+        colonia->Iteraciones_Sin_Mejora = 0;
+        return Reinicio_Estancamiento;
+    }
+
+    // Evaporación con el límite inferior, los depósitos solo pueden subir hasta tau_max. tau_min solo crece, así que aplicarlo
+    // al leer da lo mismo, salvo redondeo, que aplicarlo en cada evaporación
+    Evaporar_Feromonas(colonia, Minimo);
+    if (Mejor_Hormiga != NULL && Iteracion % MMAS_CADA_MEJOR_GLOBAL != 0)
+    {
+        Depositar_Rutas(colonia, Mejor_Hormiga->Nodos, Mejor_Hormiga->Inicio_Ruta, Mejor_Hormiga->Numero_Rutas, 1.0 / Mejor_Hormiga->Distancia,
+                        Maximo);
+    }
+    else
+    {
+        Depositar_Rutas(colonia, Mejor->Nodos, Mejor->Inicio_Ruta, Mejor->Numero_Rutas, 1.0 / Mejor->Mejor_Distancia, Maximo);
+    }
+    return false;
+}
+
+// Ant Colony System: cada arco que recorre una hormiga se acerca a tau0 en cuanto lo recorre (actualización local, Xi) y solo los
+// arcos de la mejor solución global se evaporan y reciben su depósito (Rho). tau0 = 1 / (Numero_Clientes * distancia de la
+// primera solución completa), antes de conocerla no hay actualización local. Cada hilo hace la actualización local en su tabla
+// (Actualizar_Arco_Local), así sus hormigas la ven paso a paso; las de otros hilos la ven desde la siguiente iteración, cuando
+// aquí se repite sobre la matriz compartida hilo por hilo y en el orden en que se hizo. El resultado es reproducible para un
+// mismo número de hilos pero depende de él. Solo cambian los arcos usados, así que su numerador se recalcula aquí y no hace falta
+// Actualizar_Atractivo
+static void Actualizar_Feromonas_ACS(Colonia *colonia, const Resultado_Colonia *Mejor)
+{
+    if (!isfinite(Mejor->Mejor_Distancia))
+    {
+        return;
+    }
+    if (!colonia->Feromonas_Escaladas)
+    {
+        colonia->Feromona_Inicial = 1.0 / (colonia->instancia->Numero_Clientes * Mejor->Mejor_Distancia);
+        colonia->Feromonas_Escaladas = true;
+        inicializar_feromonas(colonia, colonia->Feromona_Inicial);
+        Actualizar_Atractivo(colonia);
+    }
+    int n = colonia->instancia->Numero_Clientes;
+    for (int t = 0; t < colonia->Numero_Hilos; t++)
+    {
+        const Hilo_Construccion *Hilo = &colonia->Hilos[t];
+        for (int k = 0; k < Hilo->Numero_Actualizaciones; k++)
+        {
+            int Arco = Hilo->Actualizaciones[k];
+            Mezclar_Arco(colonia, Arco / n, Arco % n, colonia->Configuracion.Xi, colonia->Feromona_Inicial);
+        }
+    }
+    Mezclar_Rutas(colonia, Mejor->Nodos, Mejor->Inicio_Ruta, Mejor->Numero_Rutas, colonia->Configuracion.Rho, 1.0 / Mejor->Mejor_Distancia);
+}
+
+// Los depósitos ya se sumaron, la memoria temporal de la iteración se libera de golpe
+static void Reiniciar_Memoria_Hilos(Colonia *colonia)
+{
+    for (int t = 0; t < colonia->Numero_Hilos; t++)
+    {
+        Reiniciar_Arena(&colonia->Hilos[t].Memoria);
+    }
+}
+
+// Copia las rutas de la solución de una hormiga al resultado en memoria, tienen la misma forma así que solo se copian los arreglos
+static bool Exportar_Mejor_Ruta(const Hormiga *hormiga, Resultado_Colonia *Resultado)
+{
+    int Total_Nodos = hormiga->Inicio_Ruta[hormiga->Numero_Rutas];
+
+    int *Nodos = realloc(Resultado->Nodos, (Total_Nodos > 0 ? Total_Nodos : 1) * sizeof(int));
+    if (Nodos == NULL)
+    {
+        return false;
+    }
+    Resultado->Nodos = Nodos;
+
+    int *Inicio_Ruta = realloc(Resultado->Inicio_Ruta, (hormiga->Numero_Rutas + 1) * sizeof(int));
+    if (Inicio_Ruta == NULL)
+    {
+        return false;
+    }
+    Resultado->Inicio_Ruta = Inicio_Ruta;
+
+    memcpy(Resultado->Nodos, hormiga->Nodos, Total_Nodos * sizeof(int));
+    memcpy(Resultado->Inicio_Ruta, hormiga->Inicio_Ruta, (hormiga->Numero_Rutas + 1) * sizeof(int));
+    Resultado->Numero_Rutas = hormiga->Numero_Rutas;
+    Resultado->Mejor_Distancia = hormiga->Distancia;
+    return true;
+}
+
+// Número de hilos de construcción: el configurado o uno por núcleo, nunca más que hormigas
+static int Calcular_Numero_Hilos(const Configuracion_Colonia *Configuracion)
+{
+    int Numero_Hilos = Configuracion->Numero_Hilos;
+    if (Numero_Hilos <= 0)
+    {
+#ifdef _SC_NPROCESSORS_ONLN
+        long Nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+        Numero_Hilos = Nucleos > 0 ? (int)Nucleos : 1;
+#else
+        Numero_Hilos = 1;
+#endif
+    }
+    if (Numero_Hilos > Configuracion->Numero_Hormigas)
+    {
+        Numero_Hilos = Configuracion->Numero_Hormigas;
+    }
+    return Numero_Hilos;
+}
+
+// Libera la colonia y todo lo que tiene reservado
+static void Liberar_Colonia(Colonia *colonia)
+{
+    Detener_Hilos(colonia);
+    if (colonia->Hormigas != NULL)
+    {
+        for (int h = 0; h < colonia->Configuracion.Numero_Hormigas; h++)
+        {
+            free(colonia->Hormigas[h].Nodos);
+            free(colonia->Hormigas[h].Inicio_Ruta);
+        }
+    }
+    if (colonia->Hilos != NULL)
+    {
+        for (int t = 0; t < colonia->Numero_Hilos; t++)
+        {
+            Liberar_Arena(&colonia->Hilos[t].Memoria);
+        }
+    }
+    Liberar_Arena(&colonia->Mejora.Memoria);
+    free(colonia->Hormigas);
+    free(colonia->Hilos);
+    Liberar_Matriz(colonia->feromonas);
+    Liberar_Matriz(colonia->heuristica);
+    Liberar_Matriz(colonia->atractivo);
+    free(colonia);
+}
+
+// Agrega un cliente al final del arreglo de la instancia, el arreglo crece conforme se necesita
+static bool Agregar_Cliente(Instancia *instancia, Customer cliente, int *Capacidad_Clientes, const char *Ruta)
+{
+    // Los clientes se usan como índice de las matrices, deben venir en orden desde el deposito
+    if (cliente.Cliente != instancia->Numero_Clientes)
+    {
+        fprintf(stderr, "Cliente %d fuera de orden en %s\n", cliente.Cliente, Ruta);
+        return false;
+    }
+    if (instancia->Numero_Clientes == *Capacidad_Clientes)
+    {
+        int Nueva = *Capacidad_Clientes * 2 + 128;
+        Customer *clientes = realloc(instancia->clientes, Nueva * sizeof(Customer));
+        if (clientes == NULL)
+        {
+            fprintf(stderr, "Error al asignar memoria\n");
+            return false;
+        }
+        instancia->clientes = clientes;
+        *Capacidad_Clientes = Nueva;
+    }
+    instancia->clientes[instancia->Numero_Clientes++] = cliente;
+    return true;
+}
+
+// Las matrices y los candidatos solo dependen de las coordenadas de los clientes, la velocidad y el número de candidatos, así
+// que la llave de la cache es un FNV-1a de 64 bits de esos datos: dos instancias con los mismos clientes (C101 y C102) la comparten
+static uint64_t Llave_Cache(const Instancia *instancia)
+{
+    uint64_t Llave = 14695981039346656037ULL;
+    double Datos_Modelo[4] = {VERSION_CACHE, VELOCIDAD_VEHICULO, instancia->Numero_Clientes, instancia->Numero_Candidatos};
+    const unsigned char *Bytes = (const unsigned char *)Datos_Modelo;
+    for (size_t i = 0; i < sizeof(Datos_Modelo); i++)
+    {
+        Llave = (Llave ^ Bytes[i]) * 1099511628211ULL;
+    }
+    for (int c = 0; c < instancia->Numero_Clientes; c++)
+    {
+        double Coordenadas[2] = {instancia->clientes[c].xCoord, instancia->clientes[c].yCoord};
+        Bytes = (const unsigned char *)Coordenadas;
+        for (size_t i = 0; i < sizeof(Coordenadas); i++)
+        {
+            Llave = (Llave ^ Bytes[i]) * 1099511628211ULL;
+        }
+    }
+    return Llave;
+}
+
+// Archivo de cache: encabezado de TAM_ENCABEZADO_CACHE bytes ("ACOCACHE", versión, marca de orden de bytes, llave, clientes,
+// candidatos, velocidad) seguido de las matrices de distancia, tiempo y visibilidad, de las coordenadas (x, y) de cada cliente
+// y de la lista de candidatos, cada bloque alineado a ALINEACION_MATRIZ. La llave solo elige el archivo: antes de usarlo se
+// comparan las coordenadas guardadas con las de la instancia, así una colisión de la llave o un archivo viejo no se confunden
+// con la entrada buena. Se guarda en el orden de bytes de la máquina, una máquina distinta simplemente no lo reconoce
+typedef struct
+{
+    char Firma[8];
+    uint32_t Version;
+    uint32_t Orden_Bytes;
+    uint64_t Llave;
+    int32_t Numero_Clientes;
+    int32_t Numero_Candidatos;
+    uint64_t Tam_Archivo;
+    double Velocidad;
+} Encabezado_Cache;
+
+// Bytes redondeados a la alineación de los bloques del archivo
+static size_t Tam_Bloque_Cache(size_t Tam)
+{
+    return (Tam + ALINEACION_MATRIZ - 1) / ALINEACION_MATRIZ * ALINEACION_MATRIZ;
+}
+
+static size_t Tam_Bloque_Matriz(int Numero_Clientes)
+{
+    return Tam_Bloque_Cache((size_t)Numero_Clientes * Numero_Clientes * sizeof(double));
+}
+
+static void Llenar_Encabezado_Cache(Encabezado_Cache *Encabezado, const Instancia *instancia, uint64_t Llave)
+{
+    memset(Encabezado, 0, sizeof(*Encabezado));
+    memcpy(Encabezado->Firma, "ACOCACHE", 8);
+    Encabezado->Version = VERSION_CACHE;
+    Encabezado->Orden_Bytes = 0x01020304;
+    Encabezado->Llave = Llave;
+    Encabezado->Numero_Clientes = instancia->Numero_Clientes;
+    Encabezado->Numero_Candidatos = instancia->Numero_Candidatos;
+    Encabezado->Tam_Archivo = TAM_ENCABEZADO_CACHE + 3 * Tam_Bloque_Matriz(instancia->Numero_Clientes) +
+                              Tam_Bloque_Cache(2 * (size_t)instancia->Numero_Clientes * sizeof(double)) +
+                              (size_t)instancia->Numero_Clientes * instancia->Numero_Candidatos * sizeof(int);
+    Encabezado->Velocidad = VELOCIDAD_VEHICULO;
+}
+
+// true si las coordenadas guardadas en la cache son exactamente las de la instancia
+static bool Coordenadas_Iguales(const double *Coordenadas, const Instancia *instancia)
+{
+    for (int c = 0; c < instancia->Numero_Clientes; c++)
+    {
+        if (memcmp(&Coordenadas[2 * c], &instancia->clientes[c].xCoord, sizeof(double)) != 0 ||
+            memcmp(&Coordenadas[2 * c + 1], &instancia->clientes[c].yCoord, sizeof(double)) != 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void Ruta_Cache(char *Ruta, size_t Tam, uint64_t Llave)
+{
+    snprintf(Ruta, Tam, "%s/%016llx.bin", DIRECTORIO_CACHE, (unsigned long long)Llave);
+}
+
+// Mapea a memoria las matrices de la cache si hay una entrada válida para la instancia, sin leerlas: las páginas se cargan
+// conforme la colonia las usa. Devuelve false si no hay cache y hay que calcularlas
+static bool Cargar_Cache(Instancia *instancia, uint64_t Llave)
+{
+#ifdef _WIN32
+    (void)instancia;
+    (void)Llave;
+    return false;
+#else
+    if (DIRECTORIO_CACHE[0] == '\0')
+    {
+        return false;
+    }
+    char Ruta[512];
+    Ruta_Cache(Ruta, sizeof(Ruta), Llave);
+    int Descriptor = open(Ruta, O_RDONLY);
+    if (Descriptor < 0)
+    {
+        return false;
+    }
+
+    Encabezado_Cache Esperado, Encabezado;
+    Llenar_Encabezado_Cache(&Esperado, instancia, Llave);
+    struct stat Estado;
+    bool Valido = fstat(Descriptor, &Estado) == 0 && (uint64_t)Estado.st_size == Esperado.Tam_Archivo &&
+                  pread(Descriptor, &Encabezado, sizeof(Encabezado), 0) == (ssize_t)sizeof(Encabezado) &&
+                  memcmp(&Encabezado, &Esperado, sizeof(Encabezado)) == 0;
+    void *Mapeo = Valido ? mmap(NULL, Esperado.Tam_Archivo, PROT_READ, MAP_SHARED, Descriptor, 0) : MAP_FAILED;
+    close(Descriptor); // El mapeo sigue válido sin el descriptor
+    if (Mapeo == MAP_FAILED)
+    {
+        return false;
+    }
+
+    // Solo se lee el bloque de coordenadas, las matrices se siguen cargando conforme se usan
+    size_t Tam_Matriz = Tam_Bloque_Matriz(instancia->Numero_Clientes);
+    char *Datos = (char *)Mapeo + TAM_ENCABEZADO_CACHE;
+    const double *Coordenadas = (const double *)(Datos + 3 * Tam_Matriz);
+    if (!Coordenadas_Iguales(Coordenadas, instancia))
+    {
+        munmap(Mapeo, Esperado.Tam_Archivo);
+        return false;
+    }
+    instancia->distancias = (double *)Datos;
+    instancia->tiempos = (double *)(Datos + Tam_Matriz);
+    instancia->visibilidad = (double *)(Datos + 2 * Tam_Matriz);
+    instancia->candidatos = (int *)(Datos + 3 * Tam_Matriz + Tam_Bloque_Cache(2 * (size_t)instancia->Numero_Clientes * sizeof(double)));
+    instancia->Cache = Mapeo;
+    instancia->Tam_Cache = Esperado.Tam_Archivo;
+    return true;
+#endif
+}
+
+// Guarda las matrices recién calculadas en la cache para la siguiente ejecución. Se escribe a un archivo temporal propio del
+// proceso y se renombra, así otro proceso nunca mapea un archivo a medias. Si no se puede guardar no pasa nada
+static void Guardar_Cache(const Instancia *instancia, uint64_t Llave)
+{
+#ifdef _WIN32
+    (void)instancia;
+    (void)Llave;
+#else
+    if (DIRECTORIO_CACHE[0] == '\0')
+    {
+        return;
+    }
+    mkdir(DIRECTORIO_CACHE, 0777); // Si ya existe falla sin problema
+
+    char Ruta[512], Temporal[540];
+    Ruta_Cache(Ruta, sizeof(Ruta), Llave);
+    snprintf(Temporal, sizeof(Temporal), "%s.%ld.tmp", Ruta, (long)getpid());
+    FILE *archivo = fopen(Temporal, "wb");
+    if (archivo == NULL)
+    {
+        return;
+    }
+
+    int n = instancia->Numero_Clientes;
+    size_t Elementos = (size_t)n * n;
+    size_t Relleno = Tam_Bloque_Matriz(n) - Elementos * sizeof(double);
+    static const char Ceros[ALINEACION_MATRIZ] = {0};
+    Encabezado_Cache Encabezado;
+    Llenar_Encabezado_Cache(&Encabezado, instancia, Llave);
+    char Bloque_Encabezado[TAM_ENCABEZADO_CACHE] = {0};
+    memcpy(Bloque_Encabezado, &Encabezado, sizeof(Encabezado));
+
+    bool Correcto = fwrite(Bloque_Encabezado, 1, sizeof(Bloque_Encabezado), archivo) == sizeof(Bloque_Encabezado);
+    const double *Matrices[3] = {instancia->distancias, instancia->tiempos, instancia->visibilidad};
+    for (int m = 0; m < 3; m++)
+    {
+        Correcto = Correcto && fwrite(Matrices[m], sizeof(double), Elementos, archivo) == Elementos &&
+                   fwrite(Ceros, 1, Relleno, archivo) == Relleno;
+    }
+    for (int c = 0; Correcto && c < n; c++)
+    {
+        double Coordenadas[2] = {instancia->clientes[c].xCoord, instancia->clientes[c].yCoord};
+        Correcto = fwrite(Coordenadas, sizeof(double), 2, archivo) == 2;
+    }
+    size_t Relleno_Coordenadas = Tam_Bloque_Cache(2 * (size_t)n * sizeof(double)) - 2 * (size_t)n * sizeof(double);
+    Correcto = Correcto && fwrite(Ceros, 1, Relleno_Coordenadas, archivo) == Relleno_Coordenadas;
+    size_t Candidatos = (size_t)n * instancia->Numero_Candidatos;
+    Correcto = Correcto && fwrite(instancia->candidatos, sizeof(int), Candidatos, archivo) == Candidatos;
+    Correcto = fclose(archivo) == 0 && Correcto;
+    if (!Correcto || rename(Temporal, Ruta) != 0)
+    {
+        remove(Temporal);
+    }
+#endif
+}
+
+// Bloque alineado a ALINEACION_MATRIZ que se libera con Liberar_Matriz
+static void *Reservar_Alineado(size_t Tam)
+{
+    // El tamaño se redondea a la alineación como lo piden aligned_alloc y _aligned_malloc
+    Tam = (Tam + ALINEACION_MATRIZ - 1) / ALINEACION_MATRIZ * ALINEACION_MATRIZ;
+#ifdef _WIN32
+    return _aligned_malloc(Tam, ALINEACION_MATRIZ);
+#else
+    void *Bloque = NULL;
+    if (posix_memalign(&Bloque, ALINEACION_MATRIZ, Tam) != 0)
+    {
+        return NULL;
+    }
+    return Bloque;
+#endif
+}
+
+// Copia los clientes a sus columnas: un solo bloque con cada columna alineada a la línea de cache
+static bool Preparar_Columnas(Instancia *instancia)
+{
+    int n = instancia->Numero_Clientes;
+    size_t Paso = ((size_t)n * sizeof(double) + ALINEACION_MATRIZ - 1) / ALINEACION_MATRIZ * ALINEACION_MATRIZ / sizeof(double);
+    double *Bloque = Reservar_Alineado(6 * Paso * sizeof(double));
+    if (Bloque == NULL)
+    {
+        return false;
+    }
+    Columnas_Clientes *columnas = &instancia->columnas;
+    columnas->xCoord = Bloque;
+    columnas->yCoord = Bloque + Paso;
+    columnas->Demanda = Bloque + 2 * Paso;
+    columnas->Tiempo_Inicio = Bloque + 3 * Paso;
+    columnas->Fecha_Vencimiento = Bloque + 4 * Paso;
+    columnas->Tiempo_Servicio = Bloque + 5 * Paso;
+    for (int i = 0; i < n; i++)
+    {
+        const Customer *Cliente = &instancia->clientes[i];
+        columnas->xCoord[i] = Cliente->xCoord;
+        columnas->yCoord[i] = Cliente->yCoord;
+        columnas->Demanda[i] = Cliente->Demanda;
+        columnas->Tiempo_Inicio[i] = Cliente->Tiempo_Inicio;
+        columnas->Fecha_Vencimiento[i] = Cliente->Fecha_Vencimiento;
+        columnas->Tiempo_Servicio[i] = Cliente->Tiempo_Servicio;
+    }
+    return true;
+}
+
+// Valida la instancia ya leída y obtiene sus matrices y listas de candidatos de la cache o las calcula, si algo falla la
+// libera y devuelve NULL
+static Instancia *Preparar_Instancia(Instancia *instancia, const char *Ruta)
+{
+    if (instancia->Numero_Clientes < 2 || instancia->Numero_Vehiculos <= 0)
+    {
+        fprintf(stderr, "La instancia %s no tiene clientes o vehiculos\n", Ruta);
+        Liberar_Instancia(instancia);
+        return NULL;
+    }
+
+    // Sin contar al deposito ni al mismo cliente quedan Numero_Clientes - 2 vecinos
+    instancia->Numero_Candidatos = instancia->Numero_Clientes - 2 < NUMERO_CANDIDATOS ? instancia->Numero_Clientes - 2 : NUMERO_CANDIDATOS;
+    if (!Preparar_Columnas(instancia))
+    {
+        fprintf(stderr, "Error al asignar memoria\n");
+        Liberar_Instancia(instancia);
+        return NULL;
+    }
+
+    uint64_t Llave = Llave_Cache(instancia);
+    if (!Cargar_Cache(instancia, Llave))
+    {
+        instancia->distancias = Reservar_Matriz(instancia->Numero_Clientes);
+        instancia->tiempos = Reservar_Matriz(instancia->Numero_Clientes);
+        instancia->visibilidad = Reservar_Matriz(instancia->Numero_Clientes);
+        if (instancia->distancias == NULL || instancia->tiempos == NULL || instancia->visibilidad == NULL)
+        {
+            fprintf(stderr, "Error al asignar memoria\n");
+            Liberar_Instancia(instancia);
+            return NULL;
+        }
+        inicializar_matrices(instancia);
+
+        instancia->candidatos = malloc(((size_t)instancia->Numero_Clientes * instancia->Numero_Candidatos + 1) * sizeof(int));
+        if (instancia->candidatos == NULL)
+        {
+            fprintf(stderr, "Error al asignar memoria\n");
+            Liberar_Instancia(instancia);
+            return NULL;
+        }
+        inicializar_candidatos(instancia);
+        Guardar_Cache(instancia, Llave);
+    }
+
+    // Los tiempos a los candidatos salen de la matriz de tiempos, no se guardan en la cache
+    instancia->tiempos_candidatos = malloc(((size_t)instancia->Numero_Clientes * instancia->Numero_Candidatos + 1) * sizeof(double));
+    if (instancia->tiempos_candidatos == NULL)
+    {
+        fprintf(stderr, "Error al asignar memoria\n");
+        Liberar_Instancia(instancia);
+        return NULL;
+    }
+    inicializar_tiempos_candidatos(instancia);
+    return instancia;
+}
+
+Instancia *Cargar_Instancia_CSV(const char *Ruta)
+{
+    // Abrir el archivo de entrada
+    FILE *archivo = fopen(Ruta, "r");
+    // Manejo de errores si no se pudo abrir el archivo
+    if (archivo == NULL)
+    {
+        fprintf(stderr, "No se pudo abrir el archivo %s\n", Ruta);
+        return NULL;
+    }
+
+    Instancia *instancia = calloc(1, sizeof(Instancia));
+    if (instancia == NULL)
+    {
+        fprintf(stderr, "Error al asignar memoria\n");
+        fclose(archivo);
+        return NULL;
+    }
+
+    // Leer información de la instancia desde el archivo
+    if (fscanf(archivo, "%49s", instancia->nombre) != 1 ||
+        fscanf(archivo, "%d,%d", &instancia->Numero_Vehiculos, &instancia->Capacidad) != 2)
+    {
+        fprintf(stderr, "Formato de instancia invalido en %s\n", Ruta);
+        fclose(archivo);
+        Liberar_Instancia(instancia);
+        return NULL;
+    }
+
+    // Leer información de clientes desde el archivo hasta el final
+    int Capacidad_Clientes = 0;
+    Customer cliente;
+    while (fscanf(archivo, "%d,%lf,%lf,%d,%lf,%lf,%lf",
+                  &cliente.Cliente, &cliente.xCoord, &cliente.yCoord,
+                  &cliente.Demanda, &cliente.Tiempo_Inicio,
+                  &cliente.Fecha_Vencimiento, &cliente.Tiempo_Servicio) == 7)
+    {
+        if (!Agregar_Cliente(instancia, cliente, &Capacidad_Clientes, Ruta))
+        {
+            fclose(archivo);
+            Liberar_Instancia(instancia);
+            return NULL;
+        }
+    }
+
+    // Cerrar el archivo después de la lectura
+    fclose(archivo);
+    return Preparar_Instancia(instancia, Ruta);
+}
+
+Instancia *Cargar_Instancia_Solomon(const char *Ruta)
+{
+    FILE *archivo = fopen(Ruta, "r");
+    if (archivo == NULL)
+    {
+        fprintf(stderr, "No se pudo abrir el archivo %s\n", Ruta);
+        return NULL;
+    }
+
+    Instancia *instancia = calloc(1, sizeof(Instancia));
+    if (instancia == NULL)
+    {
+        fprintf(stderr, "Error al asignar memoria\n");
+        fclose(archivo);
+        return NULL;
+    }
+
+    // El archivo tiene el nombre en el primer renglón, luego la sección VEHICLE (número y capacidad) y la sección CUSTOMER
+    // (un cliente por renglón). Los encabezados de columnas no son números así que no se confunden con datos
+    enum { NOMBRE, VEHICULOS, CLIENTES, OTRA } Seccion = NOMBRE;
+    bool Hay_Vehiculos = false;
+    int Capacidad_Clientes = 0;
+    char Renglon[512];
+    while (fgets(Renglon, sizeof(Renglon), archivo) != NULL)
+    {
+        char Palabra[50];
+        if (sscanf(Renglon, "%49s", Palabra) != 1)
+        {
+            continue; // Renglón vacío
+        }
+
+        if (Seccion == NOMBRE)
+        {
+            strcpy(instancia->nombre, Palabra);
+            Seccion = OTRA;
+        }
+        else if (strcmp(Palabra, "VEHICLE") == 0)
+        {
+            Seccion = VEHICULOS;
+        }
+        else if (strcmp(Palabra, "CUSTOMER") == 0)
+        {
+            Seccion = CLIENTES;
+        }
+        else if (Seccion == VEHICULOS)
+        {
+            Hay_Vehiculos = Hay_Vehiculos || sscanf(Renglon, "%d %d", &instancia->Numero_Vehiculos, &instancia->Capacidad) == 2;
+        }
+        else if (Seccion == CLIENTES)
+        {
+            Customer cliente;
+            if (sscanf(Renglon, "%d %lf %lf %d %lf %lf %lf",
+                       &cliente.Cliente, &cliente.xCoord, &cliente.yCoord,
+                       &cliente.Demanda, &cliente.Tiempo_Inicio,
+                       &cliente.Fecha_Vencimiento, &cliente.Tiempo_Servicio) == 7 &&
+                !Agregar_Cliente(instancia, cliente, &Capacidad_Clientes, Ruta))
+            {
+                fclose(archivo);
+                Liberar_Instancia(instancia);
+                return NULL;
+            }
+        }
+    }
+    fclose(archivo);
+
+    if (!Hay_Vehiculos)
+    {
+        fprintf(stderr, "Formato de instancia invalido en %s\n", Ruta);
+        Liberar_Instancia(instancia);
+        return NULL;
+    }
+    return Preparar_Instancia(instancia, Ruta);
+}
+
+Instancia *Cargar_Instancia(const char *Ruta)
+{
+    const char *Extension = strrchr(Ruta, '.');
+    if (Extension != NULL && (strcmp(Extension, ".txt") == 0 || strcmp(Extension, ".TXT") == 0))
+    {
+        return Cargar_Instancia_Solomon(Ruta);
+    }
+    return Cargar_Instancia_CSV(Ruta);
+}
+
+bool Cargar_Solucion_Solomon(const char *Ruta, Resultado_Colonia *Solucion)
+{
+    Solucion->Mejor_Distancia = INFINITY;
+    Solucion->Numero_Rutas = 0;
+    Solucion->Pasos_Construccion = 0;
+    memset(&Solucion->Estadisticas, 0, sizeof(Solucion->Estadisticas));
+    Solucion->Inicio_Ruta = NULL;
+    Solucion->Nodos = NULL;
+
+    FILE *archivo = fopen(Ruta, "r");
+    if (archivo == NULL)
+    {
+        return false;
+    }
+
+    // Cada ruta se guarda como en el resultado de la colonia: empieza y termina en el deposito
+    int Capacidad_Rutas = 0, Capacidad_Nodos = 0, Total_Nodos = 0;
+    bool Correcto = true;
+    char Renglon[4096];
+    while (Correcto && fgets(Renglon, sizeof(Renglon), archivo) != NULL)
+    {
+        double Costo;
+        if (sscanf(Renglon, " Cost %lf", &Costo) == 1)
+        {
+            Solucion->Mejor_Distancia = Costo;
+            continue;
+        }
+        char *Clientes = strchr(Renglon, ':');
+        if (strncmp(Renglon, "Route", 5) != 0 || Clientes == NULL)
+        {
+            continue;
+        }
+
+        // Crece los arreglos si hace falta: una ruta más y a lo más un nodo por cada dos caracteres más los dos depósitos
+        int Maximo_Nodos = Total_Nodos + (int)strlen(Clientes) / 2 + 3;
+        if (Solucion->Numero_Rutas + 2 > Capacidad_Rutas)
+        {
+            Capacidad_Rutas = Capacidad_Rutas * 2 + 32;
+            int *Inicio_Ruta = realloc(Solucion->Inicio_Ruta, Capacidad_Rutas * sizeof(int));
+            Correcto = Inicio_Ruta != NULL;
+            Solucion->Inicio_Ruta = Correcto ? Inicio_Ruta : Solucion->Inicio_Ruta;
+        }
+        if (Correcto && Maximo_Nodos > Capacidad_Nodos)
+        {
+            Capacidad_Nodos = Maximo_Nodos * 2;
+            int *Nodos = realloc(Solucion->Nodos, Capacidad_Nodos * sizeof(int));
+            Correcto = Nodos != NULL;
+            Solucion->Nodos = Correcto ? Nodos : Solucion->Nodos;
+        }
+        if (!Correcto)
+        {
+            break;
+        }
+
+        Solucion->Inicio_Ruta[Solucion->Numero_Rutas++] = Total_Nodos;
+        Solucion->Nodos[Total_Nodos++] = 0;
+        char *Actual = Clientes + 1;
+        char *Fin;
+        for (long Cliente = strtol(Actual, &Fin, 10); Fin != Actual; Cliente = strtol(Actual, &Fin, 10))
+        {
+            Solucion->Nodos[Total_Nodos++] = (int)Cliente;
+            Actual = Fin;
+        }
+        Solucion->Nodos[Total_Nodos++] = 0;
+    }
+    fclose(archivo);
+
+    if (!Correcto || Solucion->Numero_Rutas == 0)
+    {
+        Liberar_Resultado(Solucion);
+        return false;
+    }
+    Solucion->Inicio_Ruta[Solucion->Numero_Rutas] = Total_Nodos;
+    return true;
+}
+
+bool Buscar_Solucion_Conocida(const char *Ruta_Instancia, const Instancia *instancia, Resultado_Colonia *Solucion)
+{
+    char Ruta[512];
+    const char *Extension = strrchr(Ruta_Instancia, '.');
+    size_t Longitud = Extension != NULL ? (size_t)(Extension - Ruta_Instancia) : strlen(Ruta_Instancia);
+    snprintf(Ruta, sizeof(Ruta), "%.*s.sol", (int)Longitud, Ruta_Instancia);
+    if (Cargar_Solucion_Solomon(Ruta, Solucion))
+    {
+        return true;
+    }
+    snprintf(Ruta, sizeof(Ruta), "Instancias/Vrp-Set-Solomon/%s.sol", instancia->nombre);
+    return Cargar_Solucion_Solomon(Ruta, Solucion);
+}
+
+void Liberar_Instancia(Instancia *instancia)
+{
+    if (instancia == NULL)
+    {
+        return;
+    }
+    free(instancia->clientes);
+    Liberar_Matriz(instancia->columnas.xCoord);
+    free(instancia->tiempos_candidatos);
+#ifndef _WIN32
+    if (instancia->Cache != NULL)
+    {
+        munmap(instancia->Cache, instancia->Tam_Cache);
+        free(instancia);
+        return;
+    }
+#endif
+    Liberar_Matriz(instancia->distancias);
+    Liberar_Matriz(instancia->tiempos);
+    Liberar_Matriz(instancia->visibilidad);
+    free(instancia->candidatos);
+    free(instancia);
+}
+
+double *Reservar_Matriz(int Numero_Clientes)
+{
+    return Reservar_Alineado((size_t)Numero_Clientes * (size_t)Numero_Clientes * sizeof(double));
+}
+
+void Liberar_Matriz(double *Matriz)
+{
+#ifdef _WIN32
+    _aligned_free(Matriz);
+#else
+    free(Matriz);
+#endif
+}
+
+void Liberar_Resultado(Resultado_Colonia *Resultado)
+{
+    free(Resultado->Nodos);
+    free(Resultado->Inicio_Ruta);
+    Resultado->Nodos = NULL;
+    Resultado->Inicio_Ruta = NULL;
+    Resultado->Numero_Rutas = 0;
+}
+
+void Configurar_Estrategia(Configuracion_Colonia *Configuracion, int Estrategia)
+{
+    Configuracion->Estrategia = Estrategia;
+    Configuracion->Q0 = 0.9;
+    Configuracion->Xi = 0.1;
+    Configuracion->Reinicio_Estancamiento = 100;
+}
+
+// Lee una opción de la estrategia, false si no es una de ellas o su valor no se pudo leer
+static bool Leer_Opcion_Colonia(const char *Argumento, Configuracion_Colonia *Configuracion)
+{
+    static const char *Estrategias[] = {"as", "mmas", "acs"};
+    char *Fin;
+    if (strncmp(Argumento, "--estrategia=", 13) == 0)
+    {
+        for (int e = 0; e < (int)(sizeof(Estrategias) / sizeof(Estrategias[0])); e++)
+        {
+            if (strcmp(Argumento + 13, Estrategias[e]) == 0)
+            {
+                // Los parámetros que ya se dieron se conservan sin importar el orden de las opciones
+                Configuracion->Estrategia = e;
+                return true;
+            }
+        }
+        return false;
+    }
+    if (strncmp(Argumento, "--q0=", 5) == 0)
+    {
+        Configuracion->Q0 = strtod(Argumento + 5, &Fin);
+        return Fin != Argumento + 5 && *Fin == '\0';
+    }
+    if (strncmp(Argumento, "--xi=", 5) == 0)
+    {
+        Configuracion->Xi = strtod(Argumento + 5, &Fin);
+        return Fin != Argumento + 5 && *Fin == '\0';
+    }
+    if (strncmp(Argumento, "--reinicio=", 11) == 0)
+    {
+        Configuracion->Reinicio_Estancamiento = (int)strtol(Argumento + 11, &Fin, 10);
+        return Fin != Argumento + 11 && *Fin == '\0';
+    }
+    return false;
+}
+
+int Separar_Opciones_Colonia(int argc, char *argv[], Configuracion_Colonia *Configuracion)
+{
+    int Posicionales = 1;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strncmp(argv[i], "--", 2) != 0)
+        {
+            argv[Posicionales++] = argv[i];
+        }
+        else if (!Leer_Opcion_Colonia(argv[i], Configuracion))
+        {
+            fprintf(stderr, "Opcion invalida: %s\n", argv[i]);
+            return -1;
+        }
+    }
+    argv[Posicionales] = NULL;
+    return Posicionales;
+}
+
+// Revisa los parámetros de la estrategia de feromonas: MMAS y ACS necesitan 0 < Rho <= 1 (tau_max y el depósito de ACS dividen
+// o multiplican por Rho), y Q0 y Xi son probabilidad y fracción
+static bool Estrategia_Valida(const Configuracion_Colonia *Configuracion)
+{
+    switch (Configuracion->Estrategia)
+    {
+    case ESTRATEGIA_AS:
+        return true;
+    case ESTRATEGIA_MMAS:
+        return Configuracion->Rho > 0.0 && Configuracion->Rho <= 1.0;
+    case ESTRATEGIA_ACS:
+        return Configuracion->Rho > 0.0 && Configuracion->Rho <= 1.0 && Configuracion->Q0 >= 0.0 && Configuracion->Q0 <= 1.0 &&
+               Configuracion->Xi >= 0.0 && Configuracion->Xi <= 1.0;
+    default:
+        return false;
+    }
+}
+
+// Reserva la colonia para una ejecución: hormigas con su generador sembrado, arenas de los hilos y las matrices de feromonas,
+// heurística y atractivo ya inicializadas. Devuelve NULL si falta memoria
+static Colonia *Crear_Colonia(const Instancia *instancia, const Configuracion_Colonia *Configuracion)
+{
+    int num_hormigas = Configuracion->Numero_Hormigas;
+
+    Colonia *colonia = malloc(sizeof(Colonia));
+    if (colonia == NULL)
+    {
+        return NULL;
+    }
+    colonia->instancia = instancia;
+    colonia->Configuracion = *Configuracion;
+    colonia->Numero_Hilos = Calcular_Numero_Hilos(Configuracion);
+    colonia->Trabajadores = NULL;
+    colonia->Hilos_Lanzados = 0;
+    memset(&colonia->Mejora, 0, sizeof(colonia->Mejora));
+    colonia->Probabilidad_Explotar = Configuracion->Estrategia == ESTRATEGIA_ACS ? Configuracion->Q0 : 0.0;
+    colonia->Feromona_Inicial = 1.0;
+    colonia->Feromona_Minima = 0.0;
+    colonia->Feromonas_Escaladas = false;
+    colonia->Iteraciones_Sin_Mejora = 0;
+    colonia->Hormigas = calloc(num_hormigas, sizeof(Hormiga));
+    colonia->Hilos = calloc(colonia->Numero_Hilos, sizeof(Hilo_Construccion));
+    colonia->feromonas = Reservar_Matriz(instancia->Numero_Clientes);
+    colonia->heuristica = Reservar_Matriz(instancia->Numero_Clientes);
+    colonia->atractivo = Reservar_Matriz(instancia->Numero_Clientes);
+    if (colonia->Hormigas == NULL || colonia->Hilos == NULL || colonia->feromonas == NULL || colonia->heuristica == NULL ||
+        colonia->atractivo == NULL)
+    {
+        Liberar_Colonia(colonia);
+        return NULL;
+    }
+
+    // Cada hormiga guarda su solución: los Numero_Clientes - 1 clientes más un deposito al inicio y otro al final de cada ruta
+    int n = instancia->Numero_Clientes;
+    int Numero_Vehiculos = instancia->Numero_Vehiculos;
+    for (int h = 0; h < num_hormigas; h++)
+    {
+        Hormiga *hormiga = &colonia->Hormigas[h];
+        hormiga->Nodos = malloc((n + 2 * (size_t)Numero_Vehiculos) * sizeof(int));
+        hormiga->Inicio_Ruta = malloc((Numero_Vehiculos + 1) * sizeof(int));
+        if (hormiga->Nodos == NULL || hormiga->Inicio_Ruta == NULL)
+        {
+            Liberar_Colonia(colonia);
+            return NULL;
+        }
+    }
+
+    // Cada hormiga tiene su propio generador, derivado de la semilla de la ejecución
+    for (int h = 0; h < num_hormigas; h++)
+    {
+        Sembrar_Hormiga(&colonia->Hormigas[h], Configuracion->Semilla, h);
+    }
+    // Cada hilo tiene una arena con la memoria de trabajo de una construcción y los depósitos de todas sus hormigas,
+    // una solución tiene a lo más Numero_Clientes - 1 + Numero_Vehiculos arcos
+    for (int t = 0; t < colonia->Numero_Hilos; t++)
+    {
+        Hilo_Construccion *Hilo = &colonia->Hilos[t];
+        Hilo->colonia = colonia;
+        Hilo->Id = t;
+        int Hormigas_Hilo = (num_hormigas - t + colonia->Numero_Hilos - 1) / colonia->Numero_Hilos;
+        Hilo->Capacidad = Hormigas_Hilo * (n - 1 + Numero_Vehiculos);
+        Hilo->Mascara_Locales = Entradas_Locales(Hilo->Capacidad) - 1;
+        if (!Crear_Arena(&Hilo->Memoria, Tam_Memoria_Hilo(colonia, Hilo->Capacidad)))
+        {
+            Liberar_Colonia(colonia);
+            return NULL;
+        }
+    }
+
+    if (Configuracion->Hormigas_Busqueda_Local > 0 && !Crear_Busqueda_Local(&colonia->Mejora, instancia))
+    {
+        Liberar_Colonia(colonia);
+        return NULL;
+    }
+
+    // Inicializar feromonas
+    inicializar_feromonas(colonia, 1.0);
+    inicializar_heuristica(colonia);
+    Actualizar_Atractivo(colonia);
+
+    return colonia;
+}
+
+int Resolver_Colonia(const Instancia *instancia, const Configuracion_Colonia *Configuracion, Resultado_Colonia *Resultado,
+                     Observador_Iteracion Observador, void *Datos)
+{
+    int num_iteraciones = Configuracion->Numero_Iteraciones;
+    int num_hormigas = Configuracion->Numero_Hormigas;
+
+    Resultado->Mejor_Distancia = INFINITY;
+    Resultado->Numero_Rutas = 0;
+    Resultado->Pasos_Construccion = 0;
+    Resultado->Inicio_Ruta = NULL;
+    Resultado->Nodos = NULL;
+    memset(&Resultado->Estadisticas, 0, sizeof(Resultado->Estadisticas));
+
+    if (num_hormigas <= 0 || num_iteraciones < 0 || !Estrategia_Valida(Configuracion))
+    {
+        return 1;
+    }
+
+    INICIAR_MEDICION(Inicio_Preparacion);
+    Colonia *colonia = Crear_Colonia(instancia, Configuracion);
+    if (colonia == NULL)
+    {
+        return 1;
+    }
+    // Los hilos de construcción se crean una vez y esperan cada iteración hasta que se libera la colonia
+    Lanzar_Hilos(colonia);
+    TERMINAR_MEDICION(Resultado->Estadisticas.Tiempo_Preparacion, Inicio_Preparacion);
+
+    //  Bucle principal que ejecuta el Algoritmo de Colonia de Hormigas durante un número especificado de iteraciones.
+    for (int x = 0; x < num_iteraciones; x++)
+    {
+        // Todas las hormigas construyen su solución en paralelo leyendo la misma matriz de feromonas
+        INICIAR_MEDICION(Inicio_Construccion);
+        Construir_Hormigas(colonia);
+        TERMINAR_MEDICION(Resultado->Estadisticas.Tiempo_Construccion, Inicio_Construccion);
+
+        // Las mejores hormigas se mejoran con búsqueda local antes de dejar sus feromonas
+        if (Configuracion->Hormigas_Busqueda_Local > 0)
+        {
+            INICIAR_MEDICION(Inicio_Busqueda);
+            Mejorar_Mejores_Hormigas(colonia);
+            TERMINAR_MEDICION(Resultado->Estadisticas.Tiempo_Busqueda_Local, Inicio_Busqueda);
+#ifdef ESTADISTICAS
+            Sumar_Estadisticas(&Resultado->Estadisticas, &colonia->Mejora.Estadisticas);
+#endif
+        }
+        if (Configuracion->Estrategia == ESTRATEGIA_AS && !Depositos_En_Hilos(colonia))
+        {
+            Registrar_Hormigas(colonia);
+        }
+
+        // Mejor hormiga de la iteración
+        INICIAR_MEDICION(Inicio_Seleccion);
+        const Hormiga *Mejor_Hormiga = NULL;
+        for (int h = 0; h < num_hormigas; h++)
+        {
+            Hormiga *hormiga = &colonia->Hormigas[h];
+            Resultado->Pasos_Construccion += hormiga->Numero_Visitados;
+#ifdef ESTADISTICAS
+            Sumar_Estadisticas(&Resultado->Estadisticas, &hormiga->Estadisticas);
+            Resultado->Estadisticas.Hormigas_Incompletas += !hormiga->Completa;
+#endif
+            if (hormiga->Completa && (Mejor_Hormiga == NULL || hormiga->Distancia < Mejor_Hormiga->Distancia))
+            {
+                Mejor_Hormiga = hormiga;
+            }
+        }
+
+        // Verificación y actualización de la mejor solución encontrada, si ninguna hormiga completó su solución solo se evapora
+        if (Mejor_Hormiga != NULL && Mejor_Hormiga->Distancia < Resultado->Mejor_Distancia)
+        {
+            // Sin memoria para copiar las rutas el resultado quedaría a medias, se descarta completo
+            if (!Exportar_Mejor_Ruta(Mejor_Hormiga, Resultado))
+            {
+                Liberar_Resultado(Resultado);
+                Resultado->Mejor_Distancia = INFINITY;
+                Liberar_Colonia(colonia);
+                return 1;
+            }
+            colonia->Iteraciones_Sin_Mejora = 0;
+        }
+        else
+        {
+            colonia->Iteraciones_Sin_Mejora++;
+        }
+        TERMINAR_MEDICION(Resultado->Estadisticas.Tiempo_Seleccion, Inicio_Seleccion);
+
+        // Actualiza la matriz de feromonas según la estrategia: en AS con los depósitos de todos los hilos
+        INICIAR_MEDICION(Inicio_Feromonas);
+        if (Configuracion->Estrategia == ESTRATEGIA_MMAS)
+        {
+            if (Actualizar_Feromonas_MMAS(colonia, Mejor_Hormiga, Resultado, x))
+            {
+                CONTAR(Resultado->Estadisticas.Reinicios, 1);
+            }
+        }
+        else if (Configuracion->Estrategia == ESTRATEGIA_ACS)
+        {
+            Actualizar_Feromonas_ACS(colonia, Resultado);
+        }
+        else
+        {
+            for (int t = 0; t < colonia->Numero_Hilos; t++)
+            {
+                CONTAR(Resultado->Estadisticas.Depositos, colonia->Hilos[t].Numero_Depositos);
+            }
+            Actualizar_Feromonas(colonia);
+        }
+        Reiniciar_Memoria_Hilos(colonia);
+        TERMINAR_MEDICION(Resultado->Estadisticas.Tiempo_Feromonas, Inicio_Feromonas);
+
+        // ACS ya recalculó el numerador de los arcos que cambió
+        if (Configuracion->Estrategia != ESTRATEGIA_ACS)
+        {
+            INICIAR_MEDICION(Inicio_Atractivo);
+            Actualizar_Atractivo(colonia);
+            TERMINAR_MEDICION(Resultado->Estadisticas.Tiempo_Atractivo, Inicio_Atractivo);
+        }
+        CONTAR(Resultado->Estadisticas.Iteraciones, 1);
+
+        // Notifica al observador el estado al final de la iteración
+        if (Observador != NULL)
+        {
+            INICIAR_MEDICION(Inicio_Observador);
+            Feromonas_Colonia feromonas = Feromonas_Actuales(colonia);
+            Observador(x, Resultado, &feromonas, Datos);
+            TERMINAR_MEDICION(Resultado->Estadisticas.Tiempo_Observador, Inicio_Observador);
+        }
+    }
+
+    Liberar_Colonia(colonia);
+    return 0;
+}
+
+// Escriben un número en little-endian sin importar el orden de bytes de la máquina
+static void Escribir_U32_LE(unsigned char *Destino, uint32_t Valor)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        Destino[i] = (unsigned char)(Valor >> (8 * i));
+    }
+}
+
+static void Escribir_F64_LE(unsigned char *Destino, double Valor)
+{
+    uint64_t Bits;
+    memcpy(&Bits, &Valor, sizeof(Bits));
+    for (int i = 0; i < 8; i++)
+    {
+        Destino[i] = (unsigned char)(Bits >> (8 * i));
+    }
+}
+
+bool Guardar_Matriz_Binaria(const char *Ruta, int Tipo, const double *Matriz, const Instancia *instancia, int Iteracion,
+                            const Configuracion_Colonia *Configuracion)
+{
+    int n = instancia->Numero_Clientes;
+
+    unsigned char Encabezado[TAM_ENCABEZADO_MATRIZ] = {0};
+    memcpy(Encabezado, "ACOMATRZ", 8);
+    Escribir_U32_LE(Encabezado + 8, 1);
+    Escribir_U32_LE(Encabezado + 12, (uint32_t)Tipo);
+    Escribir_U32_LE(Encabezado + 16, (uint32_t)n);
+    Escribir_U32_LE(Encabezado + 20, (uint32_t)n);
+    Escribir_U32_LE(Encabezado + 24, (uint32_t)Iteracion);
+    Escribir_U32_LE(Encabezado + 28, Configuracion != NULL ? Configuracion->Semilla : 0);
+    size_t Tam_Nombre = strlen(instancia->nombre);
+    memcpy(Encabezado + 32, instancia->nombre, Tam_Nombre < 47 ? Tam_Nombre : 47); // El resto ya es 0
+    if (Configuracion != NULL)
+    {
+        Escribir_F64_LE(Encabezado + 80, Configuracion->Alpha);
+        Escribir_F64_LE(Encabezado + 88, Configuracion->Beta);
+        Escribir_F64_LE(Encabezado + 96, Configuracion->Gamma);
+        Escribir_F64_LE(Encabezado + 104, Configuracion->Rho);
+        Escribir_U32_LE(Encabezado + 112, (uint32_t)Configuracion->Numero_Iteraciones);
+        Escribir_U32_LE(Encabezado + 116, (uint32_t)Configuracion->Numero_Hormigas);
+    }
+
+    // Temporal propio del proceso, como en Guardar_Cache: dos ejecuciones sobre la misma instancia no se pisan el archivo a medias
+    size_t Tam_Ruta = strlen(Ruta) + 32;
+    char *Temporal = malloc(Tam_Ruta);
+    if (Temporal == NULL)
+    {
+        return false;
+    }
+    snprintf(Temporal, Tam_Ruta, "%s.%ld.tmp", Ruta, (long)getpid());
+
+    FILE *archivo = fopen(Temporal, "wb");
+    if (archivo == NULL)
+    {
+        free(Temporal);
+        return false;
+    }
+    bool Correcto = fwrite(Encabezado, 1, sizeof(Encabezado), archivo) == sizeof(Encabezado);
+
+    // En una máquina little-endian los datos se escriben tal cual, si no se voltean renglón por renglón
+    const uint16_t Uno = 1;
+    if (*(const unsigned char *)&Uno == 1)
+    {
+        Correcto = Correcto && fwrite(Matriz, sizeof(double), (size_t)n * n, archivo) == (size_t)n * n;
+    }
+    else
+    {
+        unsigned char *Renglon = malloc((size_t)n * 8);
+        Correcto = Correcto && Renglon != NULL;
+        for (int i = 0; Correcto && i < n; i++)
+        {
+            for (int j = 0; j < n; j++)
+            {
+                Escribir_F64_LE(Renglon + 8 * j, Matriz[i * n + j]);
+            }
+            Correcto = fwrite(Renglon, 8, n, archivo) == (size_t)n;
+        }
+        free(Renglon);
+    }
+    Correcto = fclose(archivo) == 0 && Correcto;
+
+    // rename no reemplaza un archivo existente en Windows
+#ifdef _WIN32
+    if (Correcto)
+    {
+        remove(Ruta);
+    }
+#endif
+    Correcto = Correcto && rename(Temporal, Ruta) == 0;
+    if (!Correcto)
+    {
+        remove(Temporal);
+    }
+    free(Temporal);
+    return Correcto;
+}
+
+char *Ruta_Archivo(int Tipo_Iteracion, int Numero_Iteracion)
+{
+    char *Ruta_Archivo;
+    const char *CSV = "Vectores/V_Objetivo";
+
+    // Tipo de Vector para actualizar en este momento CVS
+    // 1 = Vector Objetivo = V_Objetivo.csv
+    // 2 = Vector Ruido = V_Ruido.csv
+    // 3 = Vector Prueba = V_Prueba.csv
+    if (Tipo_Iteracion == 1)
+    {
+        CSV = "Vectores/V_Objetivo";
+    }
+    else if (Tipo_Iteracion == 2)
+    {
+        CSV = "Vectores/V_Ruido";
+    }
+    else if (Tipo_Iteracion == 3)
+    {
+        CSV = "Vectores/V_Prueba";
+    }
+
+    char Num_Ite[12];
+    sprintf(Num_Ite, "%d", Numero_Iteracion);
+
+    size_t Ruta = strlen(CSV) + strlen("/") + strlen(Num_Ite) + strlen(".csv") + 1;
+    Ruta_Archivo = malloc(Ruta);
+    if (Ruta_Archivo == NULL)
+    {
+        return NULL;
+    }
+    strcpy(Ruta_Archivo, CSV);
+    strcat(Ruta_Archivo, "/");
+    strcat(Ruta_Archivo, Num_Ite);
+    strcat(Ruta_Archivo, ".csv");
+
+    return Ruta_Archivo;
+}
+
+bool Guardar_Rutas_CSV(const Resultado_Colonia *Resultado, const char *nombreArchivo)
+{
+    // Abrir el archivo en modo de escritura
+    FILE *archivo = fopen(nombreArchivo, "w");
+    if (archivo == NULL)
+    {
+        printf("No se pudo abrir el archivo.\n");
+        return false;
+    }
+
+    // Recorrer las rutas y escribir una por renglón
+    for (int r = 0; r < Resultado->Numero_Rutas; r++)
+    {
+        for (int i = Resultado->Inicio_Ruta[r]; i < Resultado->Inicio_Ruta[r + 1]; i++)
+        {
+            fprintf(archivo, "%d", Resultado->Nodos[i]); // Escribir el dato
+            fprintf(archivo, (i + 1 < Resultado->Inicio_Ruta[r + 1]) ? "," : "\n");
+        }
+    }
+
+    // Cerrar el archivo
+    fclose(archivo);
+    return true;
+}
@@ -0,0 +1,478 @@
+// Autor: Williams Chan Pescador
+// Algorithm: Colonias de Hormigas para el VRP con ventanas de tiempo
+// Description: Resuelve un lote de instancias con varias semillas cada una y escribe un solo reporte (CSV o JSON) con la mejor
+//              distancia, los vehículos usados, el tiempo y la brecha contra el .sol de cada instancia y semilla.
+//              Cada trabajo (instancia, semilla) corre en un hilo del grupo con la colonia en un solo hilo; cada hilo tiene su
+//              propia cola de trabajos y cuando la vacía le roba a los demás, así las instancias largas (R2, RC2) no dejan
+//              núcleos sin trabajo al final
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#ifndef _WIN32
+#include <glob.h>
+#endif
+
+#include "Colonia_Hormigas.h"
+
+// Hilos del grupo, 0 = uno por núcleo; se puede cambiar al compilar con -DHILOS_LOTE=<h>
+#ifndef HILOS_LOTE
+#define HILOS_LOTE 0
+#endif
+
+// Una instancia del lote, se carga una sola vez y la comparten todas sus semillas
+typedef struct
+{
+    char *Ruta;                // Archivo de la instancia
+    Instancia *instancia;      // Instancia cargada
+    bool Hay_Conocida;         // Si se encontró su .sol
+    double Distancia_Conocida; // Costo de la mejor solución conocida
+    int Vehiculos_Conocidos;   // Rutas de la mejor solución conocida
+} Instancia_Lote;
+
+// Resultado de resolver una instancia con una semilla
+typedef struct
+{
+    int Indice_Instancia; // Posición de la instancia en el lote
+    unsigned int Semilla; // Semilla de la colonia
+    double Distancia;     // Mejor distancia encontrada, INFINITY si ninguna hormiga completó una solución
+    int Vehiculos;        // Rutas de la mejor solución
+    double Tiempo;        // Segundos que tardó la colonia
+    bool Correcto;        // Si Resolver_Colonia aceptó los parámetros
+} Trabajo_Lote;
+
+// Cola de trabajos de un hilo: el dueño toma del final y los demás roban del inicio
+typedef struct
+{
+    pthread_mutex_t Candado;
+    int *Trabajos; // Índices en el arreglo de trabajos
+    int Inicio;    // Siguiente trabajo que se puede robar
+    int Fin;       // Uno después del siguiente trabajo del dueño
+} Cola_Trabajos;
+
+typedef struct
+{
+    Instancia_Lote *Instancias;
+    Trabajo_Lote *Trabajos;
+    int Numero_Trabajos;
+    Cola_Trabajos *Colas;
+    int Numero_Hilos;
+    Configuracion_Colonia Configuracion; // Parámetros comunes, cada trabajo cambia la semilla
+    pthread_mutex_t Candado_Salida;      // Para que los avances no se mezclen en la consola
+    int Terminados;
+} Lote;
+
+typedef struct
+{
+    Lote *lote;
+    int Id;
+} Hilo_Lote;
+
+// Tiempo monotónico en segundos
+static double Tiempo_Actual(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+// Agrega una ruta al arreglo de rutas del lote, el arreglo crece conforme se necesita
+static bool Agregar_Ruta(char ***Rutas, int *Numero_Rutas, int *Capacidad, const char *Ruta)
+{
+    if (*Numero_Rutas == *Capacidad)
+    {
+        int Nueva = *Capacidad * 2 + 16;
+        char **Arreglo = realloc(*Rutas, Nueva * sizeof(char *));
+        if (Arreglo == NULL)
+        {
+            return false;
+        }
+        *Rutas = Arreglo;
+        *Capacidad = Nueva;
+    }
+    (*Rutas)[*Numero_Rutas] = strdup(Ruta);
+    return (*Rutas)[(*Numero_Rutas)++] != NULL;
+}
+
+static bool Es_Instancia(const char *Nombre)
+{
+    const char *Extension = strrchr(Nombre, '.');
+    return Extension != NULL && (strcmp(Extension, ".txt") == 0 || strcmp(Extension, ".csv") == 0);
+}
+
+static int Comparar_Rutas(const void *a, const void *b)
+{
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+// Expande un argumento a rutas de instancias: una carpeta aporta todos sus .txt y .csv (en orden alfabético), un patrón con
+// comodines se expande con glob (por si la consola no lo hizo) y cualquier otra cosa se toma como el archivo de una instancia
+static bool Expandir_Argumento(const char *Argumento, char ***Rutas, int *Numero_Rutas, int *Capacidad)
+{
+    struct stat Estado;
+    if (stat(Argumento, &Estado) == 0 && S_ISDIR(Estado.st_mode))
+    {
+        DIR *Carpeta = opendir(Argumento);
+        if (Carpeta == NULL)
+        {
+            fprintf(stderr, "No se pudo abrir la carpeta %s\n", Argumento);
+            return false;
+        }
+        int Primera = *Numero_Rutas;
+        bool Correcto = true;
+        struct dirent *Entrada;
+        while (Correcto && (Entrada = readdir(Carpeta)) != NULL)
+        {
+            if (Es_Instancia(Entrada->d_name))
+            {
+                char Ruta[1024];
+                snprintf(Ruta, sizeof(Ruta), "%s/%s", Argumento, Entrada->d_name);
+                Correcto = Agregar_Ruta(Rutas, Numero_Rutas, Capacidad, Ruta);
+            }
+        }
+        closedir(Carpeta);
+        qsort(*Rutas + Primera, *Numero_Rutas - Primera, sizeof(char *), Comparar_Rutas);
+        return Correcto;
+    }
+#ifndef _WIN32
+    if (strpbrk(Argumento, "*?[") != NULL)
+    {
+        glob_t Coincidencias;
+        if (glob(Argumento, 0, NULL, &Coincidencias) != 0)
+        {
+            fprintf(stderr, "Ninguna instancia coincide con %s\n", Argumento);
+            return false;
+        }
+        bool Correcto = true;
+        for (size_t i = 0; Correcto && i < Coincidencias.gl_pathc; i++)
+        {
+            Correcto = Agregar_Ruta(Rutas, Numero_Rutas, Capacidad, Coincidencias.gl_pathv[i]);
+        }
+        globfree(&Coincidencias);
+        return Correcto;
+    }
+#endif
+    return Agregar_Ruta(Rutas, Numero_Rutas, Capacidad, Argumento);
+}
+
+// Toma un trabajo de la cola del hilo o, si está vacía, le roba el más antiguo a otro hilo. Devuelve -1 si ya no hay trabajo
+static int Siguiente_Trabajo(Lote *lote, int Id)
+{
+    for (int i = 0; i < lote->Numero_Hilos; i++)
+    {
+        Cola_Trabajos *Cola = &lote->Colas[(Id + i) % lote->Numero_Hilos];
+        int Trabajo = -1;
+        pthread_mutex_lock(&Cola->Candado);
+        if (Cola->Inicio < Cola->Fin)
+        {
+            Trabajo = i == 0 ? Cola->Trabajos[--Cola->Fin] : Cola->Trabajos[Cola->Inicio++];
+        }
+        pthread_mutex_unlock(&Cola->Candado);
+        if (Trabajo >= 0)
+        {
+            return Trabajo;
+        }
+    }
+    return -1;
+}
+
+static void *Ejecutar_Hilo_Lote(void *Argumento)
+{
+    Hilo_Lote *Hilo = Argumento;
+    Lote *lote = Hilo->lote;
+
+    for (int t = Siguiente_Trabajo(lote, Hilo->Id); t >= 0; t = Siguiente_Trabajo(lote, Hilo->Id))
+    {
+        Trabajo_Lote *Trabajo = &lote->Trabajos[t];
+        Instancia_Lote *Actual = &lote->Instancias[Trabajo->Indice_Instancia];
+        Configuracion_Colonia Configuracion = lote->Configuracion;
+        Configuracion.Semilla = Trabajo->Semilla;
+
+        Resultado_Colonia Resultado;
+        double Inicio = Tiempo_Actual();
+        Trabajo->Correcto = Resolver_Colonia(Actual->instancia, &Configuracion, &Resultado, NULL, NULL) == 0;
+        Trabajo->Tiempo = Tiempo_Actual() - Inicio;
+        Trabajo->Distancia = Trabajo->Correcto ? Resultado.Mejor_Distancia : INFINITY;
+        Trabajo->Vehiculos = Trabajo->Correcto ? Resultado.Numero_Rutas : 0;
+        if (Trabajo->Correcto)
+        {
+            Liberar_Resultado(&Resultado);
+        }
+
+        pthread_mutex_lock(&lote->Candado_Salida);
+        lote->Terminados++;
+        printf("[%d/%d] %s semilla %u: %.2f con %d vehiculos en %.2f s\n", lote->Terminados, lote->Numero_Trabajos,
+               Actual->instancia->nombre, Trabajo->Semilla, Trabajo->Distancia, Trabajo->Vehiculos, Trabajo->Tiempo);
+        fflush(stdout);
+        pthread_mutex_unlock(&lote->Candado_Salida);
+    }
+    return NULL;
+}
+
+// Brecha porcentual contra la mejor solución conocida, NAN si no hay .sol o la colonia no encontró solución
+static double Calcular_Brecha(const Instancia_Lote *Actual, const Trabajo_Lote *Trabajo)
+{
+    if (!Actual->Hay_Conocida || !isfinite(Trabajo->Distancia))
+    {
+        return NAN;
+    }
+    return 100.0 * (Trabajo->Distancia - Actual->Distancia_Conocida) / Actual->Distancia_Conocida;
+}
+
+// En el reporte un valor que no existe se deja vacío en CSV y como null en JSON
+static void Escribir_Numero(FILE *archivo, double Valor, bool JSON)
+{
+    if (isfinite(Valor))
+    {
+        fprintf(archivo, "%.6f", Valor);
+    }
+    else if (JSON)
+    {
+        fprintf(archivo, "null");
+    }
+}
+
+static bool Escribir_Reporte(const Lote *lote, const char *Ruta)
+{
+    FILE *archivo = fopen(Ruta, "w");
+    if (archivo == NULL)
+    {
+        fprintf(stderr, "No se pudo crear el reporte %s\n", Ruta);
+        return false;
+    }
+    const char *Extension = strrchr(Ruta, '.');
+    bool JSON = Extension != NULL && strcmp(Extension, ".json") == 0;
+
+    if (JSON)
+    {
+        fprintf(archivo, "[\n");
+    }
+    else
+    {
+        fprintf(archivo, "instancia,archivo,semilla,mejor_distancia,vehiculos,tiempo_s,distancia_conocida,vehiculos_conocidos,brecha_pct\n");
+    }
+    for (int t = 0; t < lote->Numero_Trabajos; t++)
+    {
+        const Trabajo_Lote *Trabajo = &lote->Trabajos[t];
+        const Instancia_Lote *Actual = &lote->Instancias[Trabajo->Indice_Instancia];
+        double Conocida = Actual->Hay_Conocida ? Actual->Distancia_Conocida : NAN;
+        if (JSON)
+        {
+            fprintf(archivo, "  {\"instancia\": \"%s\", \"archivo\": \"%s\", \"semilla\": %u, \"mejor_distancia\": ",
+                    Actual->instancia->nombre, Actual->Ruta, Trabajo->Semilla);
+            Escribir_Numero(archivo, Trabajo->Distancia, true);
+            fprintf(archivo, ", \"vehiculos\": %d, \"tiempo_s\": %.6f, \"distancia_conocida\": ", Trabajo->Vehiculos, Trabajo->Tiempo);
+            Escribir_Numero(archivo, Conocida, true);
+            fprintf(archivo, ", \"vehiculos_conocidos\": ");
+            if (Actual->Hay_Conocida)
+            {
+                fprintf(archivo, "%d", Actual->Vehiculos_Conocidos);
+            }
+            else
+            {
+                fprintf(archivo, "null");
+            }
+            fprintf(archivo, ", \"brecha_pct\": ");
+            Escribir_Numero(archivo, Calcular_Brecha(Actual, Trabajo), true);
+            fprintf(archivo, "}%s\n", t + 1 < lote->Numero_Trabajos ? "," : "");
+        }
+        else
+        {
+            fprintf(archivo, "%s,%s,%u,", Actual->instancia->nombre, Actual->Ruta, Trabajo->Semilla);
+            Escribir_Numero(archivo, Trabajo->Distancia, false);
+            fprintf(archivo, ",%d,%.6f,", Trabajo->Vehiculos, Trabajo->Tiempo);
+            Escribir_Numero(archivo, Conocida, false);
+            fprintf(archivo, ",");
+            if (Actual->Hay_Conocida)
+            {
+                fprintf(archivo, "%d", Actual->Vehiculos_Conocidos);
+            }
+            fprintf(archivo, ",");
+            Escribir_Numero(archivo, Calcular_Brecha(Actual, Trabajo), false);
+            fprintf(archivo, "\n");
+        }
+    }
+    if (JSON)
+    {
+        fprintf(archivo, "]\n");
+    }
+    return fclose(archivo) == 0;
+}
+
+// Número de hilos del grupo, uno por núcleo (o HILOS_LOTE) pero no más que trabajos
+static int Numero_Hilos_Lote(int Numero_Trabajos)
+{
+    long Nucleos = HILOS_LOTE > 0 ? HILOS_LOTE : sysconf(_SC_NPROCESSORS_ONLN);
+    int Numero_Hilos = Nucleos > 0 ? (int)Nucleos : 1;
+    return Numero_Hilos < Numero_Trabajos ? Numero_Hilos : Numero_Trabajos;
+}
+
+int main(int argc, char *argv[])
+{
+    Lote lote = {0};
+    Configurar_Estrategia(&lote.Configuracion, ESTRATEGIA_AS);
+    argc = Separar_Opciones_Colonia(argc, argv, &lote.Configuracion);
+    if (argc < 0)
+    {
+        return 1;
+    }
+    if (argc < 10)
+    {
+        printf("Uso: %s <num_semillas> <num_iteraciones> <num_hormigas> <alpha> <beta> <gamma> <rho> <reporte.csv|json> <instancia|carpeta|patron>... "
+               "[--estrategia=as|mmas|acs] [--q0=<p>] [--xi=<x>] [--reinicio=<iteraciones>]\n",
+               argv[0]);
+        return 1;
+    }
+
+    int Numero_Semillas = atoi(argv[1]);
+    lote.Configuracion.Numero_Iteraciones = atoi(argv[2]);
+    lote.Configuracion.Numero_Hormigas = atoi(argv[3]);
+    lote.Configuracion.Alpha = atof(argv[4]);
+    lote.Configuracion.Beta = atof(argv[5]);
+    lote.Configuracion.Gamma = atof(argv[6]);
+    lote.Configuracion.Rho = atof(argv[7]);
+    lote.Configuracion.Numero_Hilos = 1; // El paralelismo está entre trabajos
+    lote.Configuracion.Hormigas_Busqueda_Local = HORMIGAS_BUSQUEDA_LOCAL;
+    const char *Reporte = argv[8];
+    if (Numero_Semillas <= 0)
+    {
+        fprintf(stderr, "El numero de semillas debe ser positivo\n");
+        return 1;
+    }
+
+    char **Rutas = NULL;
+    int Numero_Rutas = 0, Capacidad_Rutas = 0;
+    for (int i = 9; i < argc; i++)
+    {
+        if (!Expandir_Argumento(argv[i], &Rutas, &Numero_Rutas, &Capacidad_Rutas))
+        {
+            return 1;
+        }
+    }
+    if (Numero_Rutas == 0)
+    {
+        fprintf(stderr, "No hay instancias en el lote\n");
+        return 1;
+    }
+
+    // Cargar todas las instancias antes de empezar, cada una con su mejor solución conocida si la hay
+    double Inicio = Tiempo_Actual();
+    lote.Instancias = calloc(Numero_Rutas, sizeof(Instancia_Lote));
+    if (lote.Instancias == NULL)
+    {
+        fprintf(stderr, "Error al asignar memoria\n");
+        return 1;
+    }
+    for (int i = 0; i < Numero_Rutas; i++)
+    {
+        Instancia_Lote *Actual = &lote.Instancias[i];
+        Actual->Ruta = Rutas[i];
+        Actual->instancia = Cargar_Instancia(Rutas[i]);
+        if (Actual->instancia == NULL)
+        {
+            return 1;
+        }
+        Resultado_Colonia Solucion;
+        Actual->Hay_Conocida = Buscar_Solucion_Conocida(Rutas[i], Actual->instancia, &Solucion);
+        if (Actual->Hay_Conocida)
+        {
+            Actual->Distancia_Conocida = Solucion.Mejor_Distancia;
+            Actual->Vehiculos_Conocidos = Solucion.Numero_Rutas;
+            Liberar_Resultado(&Solucion);
+        }
+    }
+    printf("%d instancias cargadas en %.3f s\n", Numero_Rutas, Tiempo_Actual() - Inicio);
+
+    // Un trabajo por instancia y semilla; las semillas son 1..Numero_Semillas para que el lote se pueda repetir
+    lote.Numero_Trabajos = Numero_Rutas * Numero_Semillas;
+    lote.Trabajos = calloc(lote.Numero_Trabajos, sizeof(Trabajo_Lote));
+    lote.Numero_Hilos = Numero_Hilos_Lote(lote.Numero_Trabajos);
+    lote.Colas = calloc(lote.Numero_Hilos, sizeof(Cola_Trabajos));
+    Hilo_Lote *Hilos = calloc(lote.Numero_Hilos, sizeof(Hilo_Lote));
+    pthread_t *Identificadores = calloc(lote.Numero_Hilos, sizeof(pthread_t));
+    if (lote.Trabajos == NULL || lote.Colas == NULL || Hilos == NULL || Identificadores == NULL)
+    {
+        fprintf(stderr, "Error al asignar memoria\n");
+        return 1;
+    }
+    for (int t = 0; t < lote.Numero_Trabajos; t++)
+    {
+        lote.Trabajos[t].Indice_Instancia = t / Numero_Semillas;
+        lote.Trabajos[t].Semilla = (unsigned int)(t % Numero_Semillas + 1);
+    }
+
+    // Reparto inicial en bloques contiguos, el robo de trabajos corrige el desbalance
+    for (int h = 0; h < lote.Numero_Hilos; h++)
+    {
+        Cola_Trabajos *Cola = &lote.Colas[h];
+        int Primero = (int)((long)lote.Numero_Trabajos * h / lote.Numero_Hilos);
+        int Ultimo = (int)((long)lote.Numero_Trabajos * (h + 1) / lote.Numero_Hilos);
+        Cola->Trabajos = malloc((Ultimo - Primero + 1) * sizeof(int));
+        if (Cola->Trabajos == NULL)
+        {
+            fprintf(stderr, "Error al asignar memoria\n");
+            return 1;
+        }
+        for (int t = Primero; t < Ultimo; t++)
+        {
+            Cola->Trabajos[t - Primero] = t;
+        }
+        Cola->Inicio = 0;
+        Cola->Fin = Ultimo - Primero;
+        pthread_mutex_init(&Cola->Candado, NULL);
+    }
+    pthread_mutex_init(&lote.Candado_Salida, NULL);
+
+    Inicio = Tiempo_Actual();
+    int Creados = 0;
+    for (int h = 0; h < lote.Numero_Hilos; h++)
+    {
+        Hilos[h].lote = &lote;
+        Hilos[h].Id = h;
+        if (pthread_create(&Identificadores[h], NULL, Ejecutar_Hilo_Lote, &Hilos[h]) != 0)
+        {
+            break; // Los hilos creados roban el trabajo de los que faltaron
+        }
+        Creados++;
+    }
+    if (Creados == 0)
+    {
+        Ejecutar_Hilo_Lote(&Hilos[0]);
+    }
+    for (int h = 0; h < Creados; h++)
+    {
+        pthread_join(Identificadores[h], NULL);
+    }
+    printf("%d trabajos en %d hilos en %.2f s\n", lote.Numero_Trabajos, lote.Numero_Hilos, Tiempo_Actual() - Inicio);
+
+    int Estado = Escribir_Reporte(&lote, Reporte) ? 0 : 1;
+    if (Estado == 0)
+    {
+        printf("Reporte guardado en %s\n", Reporte);
+    }
+
+    for (int h = 0; h < lote.Numero_Hilos; h++)
+    {
+        pthread_mutex_destroy(&lote.Colas[h].Candado);
+        free(lote.Colas[h].Trabajos);
+    }
+    pthread_mutex_destroy(&lote.Candado_Salida);
+    for (int i = 0; i < Numero_Rutas; i++)
+    {
+        Liberar_Instancia(lote.Instancias[i].instancia);
+        free(Rutas[i]);
+    }
+    free(Rutas);
+    free(lote.Instancias);
+    free(lote.Trabajos);
+    free(lote.Colas);
+    free(Hilos);
+    free(Identificadores);
+    return Estado;
+}
@@ -0,0 +1,681 @@
+// Autor: Williams Chan Pescador
+// Algorithm: Colonias de Hormigas para el VRP con ventanas de tiempo
+// Description: Microbenchmark de las funciones que dominan una ejecución de la colonia, cada una medida por separado en ns por
+//              operación sobre instancias sintéticas y derivadas de Solomon (C101) de 100, 400 y 1000 clientes. Cada medición
+//              se calienta, se repite REPETICIONES veces y reporta la mediana, el mínimo y la dispersión (MAD) de las repeticiones.
+//              Las funciones son internas de la biblioteca, así que este archivo la incluye completa en lugar de enlazarla:
+//              gcc -O2 Colonia_Microbenchmark.c -o Colonia_Microbenchmark -lm -pthread
+
+// Las instancias del microbenchmark no se guardan en la cache de matrices
+#define DIRECTORIO_CACHE ""
+#include "Colonia_Hormigas_Lib.c"
+
+#include <time.h>
+
+// Repeticiones de cada medición y tiempo mínimo de cada repetición y del calentamiento, en segundos
+#ifndef REPETICIONES
+#define REPETICIONES 11
+#endif
+#define TIEMPO_REPETICION 0.01
+#define TIEMPO_CALENTAMIENTO 0.05
+
+// Estados de origen distintos que recorre Calculo_Probabilidad para no medir siempre el mismo paso
+#define NUMERO_ESTADOS 256
+#define NUMERO_PARES 4096
+
+#define INSTANCIA_SOLOMON "Instancias/Vrp-Set-Solomon/C101.txt"
+
+// Paso de construcción a medio camino: un vehículo parado en Origen con su tiempo y carga
+typedef struct
+{
+    int Origen;
+    double Tiempo_Consumido;
+    int Carga;
+} Estado_Paso;
+
+// Todo lo que necesitan los núcleos para una instancia
+typedef struct
+{
+    Instancia *instancia;
+    Colonia *colonia;
+    Hormiga hormiga;                      // Hormiga propia con su memoria de trabajo
+    Estado_Paso Estados[NUMERO_ESTADOS];  // Pasos para Calculo_Probabilidad, con la mitad de los clientes ya visitados
+    bool *Visitado_Paso;                  // Clientes visitados en los pasos
+    int Pares[NUMERO_PARES][2];           // Arcos para Calcular_Numerador
+    double *Acumulados;                   // Sumas acumuladas para Seleccion_Parte
+    int *Recorrido;                       // Todos los clientes en orden aleatorio entre dos depósitos
+    bool Hay_Solucion;                    // Alguna hormiga de la colonia completó su solución, si no tampoco hay depósitos
+    int *Nodos_Construidos;               // Solución completa de una hormiga antes de la búsqueda local
+    int *Inicio_Construido;
+    int Rutas_Construidas;
+    double Distancia_Construida;
+} Banco;
+
+typedef void (*Nucleo)(Banco *banco, long Repeticiones);
+
+// Evita que el compilador descarte el trabajo de los núcleos
+static volatile double Sumidero;
+
+// Tiempo monotónico en segundos
+static double Tiempo_Actual(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+// Un paso de construcción desde un estado fijo, el cliente elegido se desmarca para que el siguiente paso parta igual
+static void Nucleo_Calculo_Probabilidad(Banco *banco, long Repeticiones)
+{
+    Hormiga *hormiga = &banco->hormiga;
+    Vehicle *Vehiculo = &hormiga->Vehiculos[0];
+    bool *Visitado_Hormiga = hormiga->Visitado;
+    hormiga->Visitado = banco->Visitado_Paso;
+    for (long r = 0; r < Repeticiones; r++)
+    {
+        const Estado_Paso *Estado = &banco->Estados[r % NUMERO_ESTADOS];
+        Vehiculo->Ultimo_Cliente = Estado->Origen;
+        Vehiculo->Tiempo_Consumido = Estado->Tiempo_Consumido;
+        Vehiculo->capacity_restant = Estado->Carga;
+        hormiga->Numero_Visitados = 0;
+        if (Calculo_Probabilidad(banco->colonia, hormiga, 0))
+        {
+            hormiga->Visitado[hormiga->Orden[0]] = false;
+        }
+    }
+    hormiga->Visitado = Visitado_Hormiga;
+}
+
+static void Nucleo_Calcular_Numerador(Banco *banco, long Repeticiones)
+{
+    double Suma = 0;
+    for (long r = 0; r < Repeticiones; r++)
+    {
+        const int *Par = banco->Pares[r % NUMERO_PARES];
+        Suma += Calcular_Numerador(banco->colonia, Par[0], Par[1]);
+    }
+    Sumidero = Suma;
+}
+
+// Filtro de factibilidad de todos los clientes desde los estados de Calculo_Probabilidad, como cuando ningún vecino es factible
+static void Nucleo_Filtrar_Todos(Banco *banco, long Repeticiones)
+{
+    Vehicle *Vehiculo = &banco->hormiga.Vehiculos[0];
+    long Suma = 0;
+    for (long r = 0; r < Repeticiones; r++)
+    {
+        const Estado_Paso *Estado = &banco->Estados[r % NUMERO_ESTADOS];
+        Vehiculo->Tiempo_Consumido = Estado->Tiempo_Consumido;
+        Vehiculo->capacity_restant = Estado->Carga;
+        Suma += Filtrar_Todos(banco->instancia, banco->Visitado_Paso, Vehiculo, Estado->Origen, banco->hormiga.Destinos_Posibles);
+    }
+    Sumidero = Suma;
+}
+
+// Sumas acumuladas de los numeradores de todos los destinos de un origen, como en Calculo_Probabilidad cuando se revisan todos
+static void Nucleo_Probabilidad(Banco *banco, long Repeticiones)
+{
+    int n = banco->instancia->Numero_Clientes;
+    for (long r = 0; r < Repeticiones; r++)
+    {
+        int Origen = (int)(r % n);
+        double Denominador = 0;
+        for (int j = 1; j < n; j++)
+        {
+            Denominador = Denominador + Calcular_Numerador(banco->colonia, Origen, j);
+            banco->hormiga.Acumulados[j - 1] = Denominador;
+        }
+    }
+    Sumidero = banco->hormiga.Acumulados[n - 2];
+}
+
+static void Seleccionar(Banco *banco, long Repeticiones, int Longitud)
+{
+    long Suma = 0;
+    for (long r = 0; r < Repeticiones; r++)
+    {
+        Suma += Seleccion_Parte(&banco->hormiga, banco->Acumulados, Longitud);
+    }
+    Sumidero = (double)Suma;
+}
+
+static void Nucleo_Seleccion_Candidatos(Banco *banco, long Repeticiones)
+{
+    Seleccionar(banco, Repeticiones, banco->instancia->Numero_Candidatos);
+}
+
+static void Nucleo_Seleccion_Todos(Banco *banco, long Repeticiones)
+{
+    Seleccionar(banco, Repeticiones, banco->instancia->Numero_Clientes - 1);
+}
+
+static void Nucleo_Construir_Solucion(Banco *banco, long Repeticiones)
+{
+    for (long r = 0; r < Repeticiones; r++)
+    {
+        Construir_Solucion(banco->colonia, &banco->hormiga);
+    }
+    Sumidero = banco->hormiga.Distancia;
+}
+
+static void Nucleo_Recorrer_Ruta_Distancia(Banco *banco, long Repeticiones)
+{
+    double Suma = 0;
+    for (long r = 0; r < Repeticiones; r++)
+    {
+        Suma += Recorrer_Ruta_Distancia(banco->Recorrido, banco->instancia->Numero_Clientes + 1, banco->instancia);
+    }
+    Sumidero = Suma;
+}
+
+// Evaporación de toda la matriz más los depósitos de la última iteración de las hormigas de la colonia. Se mide con Rho = 0:
+// millones de evaporaciones seguidas dejarían en cero o subnormales las feromonas de los arcos sin depósito, que no aparecen en
+// una ejecución normal y cambiarían lo que miden los núcleos siguientes. La evaporación solo cambia la escala, así que no se
+// deja de medir nada más que la normalización de la matriz, que ocurre cada ~2200 iteraciones
+static void Nucleo_Actualizar_Feromonas(Banco *banco, long Repeticiones)
+{
+    double Rho = banco->colonia->Configuracion.Rho;
+    banco->colonia->Configuracion.Rho = 0;
+    for (long r = 0; r < Repeticiones; r++)
+    {
+        Actualizar_Feromonas(banco->colonia);
+    }
+    banco->colonia->Configuracion.Rho = Rho;
+}
+
+// Búsqueda local desde la misma solución construida cada vez, incluye copiarla a la hormiga (O(n))
+static void Nucleo_Mejorar_Hormiga(Banco *banco, long Repeticiones)
+{
+    Hormiga *hormiga = &banco->hormiga;
+    for (long r = 0; r < Repeticiones; r++)
+    {
+        memcpy(hormiga->Nodos, banco->Nodos_Construidos, banco->Inicio_Construido[banco->Rutas_Construidas] * sizeof(int));
+        memcpy(hormiga->Inicio_Ruta, banco->Inicio_Construido, (banco->Rutas_Construidas + 1) * sizeof(int));
+        hormiga->Numero_Rutas = banco->Rutas_Construidas;
+        hormiga->Distancia = banco->Distancia_Construida;
+        Mejorar_Hormiga(&banco->colonia->Mejora, banco->instancia, hormiga);
+    }
+    Sumidero = hormiga->Distancia;
+}
+
+// Numeradores de un renglón de n destinos con Alpha = ALPHA_POTENCIAS, que no tiene el atajo de Alpha = 1
+#define ALPHA_POTENCIAS 1.5
+
+static void Potencias(Banco *banco, long Repeticiones, bool Vectorial)
+{
+    const Colonia *colonia = banco->colonia;
+    int n = banco->instancia->Numero_Clientes;
+    for (long r = 0; r < Repeticiones; r++)
+    {
+        int i = (int)(r % n);
+        (Vectorial ? Potencias_Atractivo : Potencias_Escalar)(&colonia->feromonas[i * n], &colonia->heuristica[i * n], n,
+                                                             colonia->Escala_Feromonas, colonia->Feromona_Minima, ALPHA_POTENCIAS,
+                                                             banco->hormiga.Acumulados);
+    }
+    Sumidero = banco->hormiga.Acumulados[n - 1];
+}
+
+static void Nucleo_Potencias_Atractivo(Banco *banco, long Repeticiones)
+{
+    Potencias(banco, Repeticiones, true);
+}
+
+static void Nucleo_Potencias_Escalar(Banco *banco, long Repeticiones)
+{
+    Potencias(banco, Repeticiones, false);
+}
+
+// Diferencia relativa máxima entre Potencias_Atractivo y pow en todos los arcos de la colonia
+static double Diferencia_Potencias(Banco *banco)
+{
+    const Colonia *colonia = banco->colonia;
+    int n = banco->instancia->Numero_Clientes;
+    double *Vectorial = banco->hormiga.Acumulados, *Escalar = banco->Acumulados;
+    double Diferencia = 0;
+    for (int i = 0; i < n; i++)
+    {
+        Potencias_Atractivo(&colonia->feromonas[i * n], &colonia->heuristica[i * n], n, colonia->Escala_Feromonas,
+                            colonia->Feromona_Minima, ALPHA_POTENCIAS, Vectorial);
+        Potencias_Escalar(&colonia->feromonas[i * n], &colonia->heuristica[i * n], n, colonia->Escala_Feromonas,
+                          colonia->Feromona_Minima, ALPHA_POTENCIAS, Escalar);
+        for (int j = 0; j < n; j++)
+        {
+            if (Escalar[j] != Vectorial[j])
+            {
+                Diferencia = fmax(Diferencia, fabs(Vectorial[j] - Escalar[j]) / fabs(Escalar[j]));
+            }
+        }
+    }
+    return Diferencia;
+}
+
+// Iteraciones de la comparación de la evaporación: con Rho = 0.1 la escala baja de ESCALA_MINIMA_FEROMONAS en la iteración ~2186,
+// así que la matriz se normaliza al menos una vez
+#define ITERACIONES_EVAPORACION 2500
+
+// Diferencia relativa permitida entre la evaporación en la escala y la que recorre toda la matriz. Cada iteración redondea
+// distinto en las dos, así que la diferencia crece con las iteraciones: unos cuantos ulp cada 100
+#define TOLERANCIA_EVAPORACION 1e-12
+
+// Diferencia relativa máxima entre las feromonas de la colonia y una copia que se evapora recorriendo toda la matriz, después de
+// ITERACIONES_EVAPORACION actualizaciones con los mismos depósitos. Suma a Normalizaciones las veces que la escala volvió a 1
+static double Diferencia_Evaporacion(Banco *banco, int *Normalizaciones)
+{
+    Colonia *colonia = banco->colonia;
+    int n = banco->instancia->Numero_Clientes;
+    size_t Arcos = (size_t)n * n;
+    double *Directa = malloc(Arcos * sizeof(double)), *Escalada = malloc(Arcos * sizeof(double));
+    if (Directa == NULL || Escalada == NULL)
+    {
+        free(Directa);
+        free(Escalada);
+        return INFINITY;
+    }
+
+    Feromonas_Colonia feromonas = Feromonas_Actuales(colonia);
+    Copiar_Feromonas(&feromonas, Directa);
+    double Rho = colonia->Configuracion.Rho;
+    for (int x = 0; x < ITERACIONES_EVAPORACION; x++)
+    {
+        double Escala = colonia->Escala_Feromonas;
+        Actualizar_Feromonas(colonia);
+        *Normalizaciones += colonia->Escala_Feromonas > Escala;
+
+        // Lo mismo que hacía Actualizar_Feromonas antes de la escala
+        for (size_t i = 0; i < Arcos; i++)
+        {
+            Directa[i] *= 1 - Rho;
+        }
+        for (int t = 0; t < colonia->Numero_Hilos; t++)
+        {
+            const Hilo_Construccion *Hilo = &colonia->Hilos[t];
+            for (int d = 0; d < Hilo->Numero_Depositos; d++)
+            {
+                Directa[Hilo->Depositos[d].Origen * n + Hilo->Depositos[d].Destino] += Hilo->Depositos[d].Delta;
+            }
+        }
+        Directa[0] = 0.0;
+    }
+
+    feromonas = Feromonas_Actuales(colonia);
+    Copiar_Feromonas(&feromonas, Escalada);
+    double Diferencia = 0;
+    for (size_t i = 0; i < Arcos; i++)
+    {
+        if (Escalada[i] != Directa[i])
+        {
+            Diferencia = fmax(Diferencia, fabs(Escalada[i] - Directa[i]) / fabs(Directa[i]));
+        }
+    }
+    free(Directa);
+    free(Escalada);
+    return Diferencia;
+}
+
+static void Nucleo_Actualizar_Atractivo(Banco *banco, long Repeticiones)
+{
+    for (long r = 0; r < Repeticiones; r++)
+    {
+        Actualizar_Atractivo(banco->colonia);
+    }
+}
+
+static void Nucleo_Inicializar_Matrices(Banco *banco, long Repeticiones)
+{
+    for (long r = 0; r < Repeticiones; r++)
+    {
+        inicializar_matrices(banco->instancia);
+    }
+}
+
+static int Comparar_Double(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// Calienta el núcleo, busca cuántas operaciones hacen una repetición de al menos TIEMPO_REPETICION y mide REPETICIONES veces
+static void Medir(const char *Nombre, const char *Entrada, Banco *banco, Nucleo nucleo, FILE *CSV)
+{
+    long Operaciones = 1;
+    double Inicio = Tiempo_Actual();
+    for (;;)
+    {
+        double Antes = Tiempo_Actual();
+        nucleo(banco, Operaciones);
+        double Tiempo = Tiempo_Actual() - Antes;
+        if (Tiempo >= TIEMPO_REPETICION && Tiempo_Actual() - Inicio >= TIEMPO_CALENTAMIENTO)
+        {
+            break;
+        }
+        if (Tiempo < TIEMPO_REPETICION)
+        {
+            Operaciones *= 2;
+        }
+    }
+
+    double Muestras[REPETICIONES];
+    for (int i = 0; i < REPETICIONES; i++)
+    {
+        double Antes = Tiempo_Actual();
+        nucleo(banco, Operaciones);
+        Muestras[i] = (Tiempo_Actual() - Antes) * 1e9 / Operaciones;
+    }
+    qsort(Muestras, REPETICIONES, sizeof(double), Comparar_Double);
+    double Mediana = Muestras[REPETICIONES / 2];
+    double Desviaciones[REPETICIONES];
+    for (int i = 0; i < REPETICIONES; i++)
+    {
+        Desviaciones[i] = fabs(Muestras[i] - Mediana);
+    }
+    qsort(Desviaciones, REPETICIONES, sizeof(double), Comparar_Double);
+    double MAD = Desviaciones[REPETICIONES / 2];
+
+    int n = banco->instancia->Numero_Clientes - 1;
+    printf("%-28s %-9s %5d %14.1f %14.1f %7.1f%%\n", Nombre, Entrada, n, Mediana, Muestras[0], 100 * MAD / Mediana);
+    if (CSV != NULL)
+    {
+        fprintf(CSV, "%s,%s,%d,%.3f,%.3f,%.3f,%ld\n", Nombre, Entrada, n, Mediana, Muestras[0], MAD, Operaciones);
+    }
+}
+
+// Instancia sintética con la misma forma que las de Instancias/Generar_Instancia.py
+static Instancia *Instancia_Sintetica(int Numero_Clientes, Hormiga *Aleatorio)
+{
+    Instancia *instancia = calloc(1, sizeof(Instancia));
+    if (instancia == NULL || (instancia->clientes = malloc((Numero_Clientes + 1) * sizeof(Customer))) == NULL)
+    {
+        Liberar_Instancia(instancia);
+        return NULL;
+    }
+    snprintf(instancia->nombre, sizeof(instancia->nombre), "G%d", Numero_Clientes);
+    instancia->Numero_Clientes = Numero_Clientes + 1;
+    instancia->Numero_Vehiculos = Numero_Clientes / 4 > 25 ? Numero_Clientes / 4 : 25;
+    instancia->Capacidad = 200;
+
+    double Lado = 100 * sqrt(Numero_Clientes / 100.0);
+    double Horizonte = floor(4 * Lado + 1000);
+    instancia->clientes[0] = (Customer){0, round(Lado / 2), round(Lado / 2), 0, 0, Horizonte, 0};
+    for (int c = 1; c <= Numero_Clientes; c++)
+    {
+        double x = Aleatorio_Real(Aleatorio) * Lado, y = Aleatorio_Real(Aleatorio) * Lado;
+        double Llegada = floor(hypot(x - Lado / 2, y - Lado / 2));
+        double Inicio = floor(Aleatorio_Real(Aleatorio) * Llegada);
+        double Fin = Llegada + 60 + floor(Aleatorio_Real(Aleatorio) * (Horizonte - 2 * Llegada - 70));
+        instancia->clientes[c] = (Customer){c, round(x), round(y), 1 + Aleatorio_Entero(Aleatorio, 40), Inicio, Fin, 10};
+    }
+    return Preparar_Instancia(instancia, instancia->nombre);
+}
+
+// Instancia con los clientes de C101 repetidos hasta llegar a Numero_Clientes, las copias se mueven un poco para no empalmarse.
+// Las ventanas de C101 son angostas y la construcción no espera a que abran, así que una copia con la misma ventana que su
+// original casi nunca cabe en otra ruta y ninguna hormiga completaba su solución: la ventana de las copias se abre desde el
+// inicio del horizonte y conserva su fecha de vencimiento
+static Instancia *Instancia_Solomon(int Numero_Clientes, const Instancia *Base, Hormiga *Aleatorio)
+{
+    int Clientes_Base = Base->Numero_Clientes - 1;
+    Instancia *instancia = calloc(1, sizeof(Instancia));
+    if (instancia == NULL || (instancia->clientes = malloc((Numero_Clientes + 1) * sizeof(Customer))) == NULL)
+    {
+        Liberar_Instancia(instancia);
+        return NULL;
+    }
+    snprintf(instancia->nombre, sizeof(instancia->nombre), "%.40s_%d", Base->nombre, Numero_Clientes);
+    instancia->Numero_Clientes = Numero_Clientes + 1;
+    instancia->Numero_Vehiculos = Base->Numero_Vehiculos * Numero_Clientes / Clientes_Base;
+    instancia->Capacidad = Base->Capacidad;
+
+    instancia->clientes[0] = Base->clientes[0];
+    for (int c = 1; c <= Numero_Clientes; c++)
+    {
+        Customer cliente = Base->clientes[(c - 1) % Clientes_Base + 1];
+        if (c > Clientes_Base)
+        {
+            cliente.xCoord += Aleatorio_Real(Aleatorio) * 6 - 3;
+            cliente.yCoord += Aleatorio_Real(Aleatorio) * 6 - 3;
+            cliente.Tiempo_Inicio = Base->clientes[0].Tiempo_Inicio;
+        }
+        cliente.Cliente = c;
+        instancia->clientes[c] = cliente;
+    }
+    return Preparar_Instancia(instancia, instancia->nombre);
+}
+
+// Prepara la colonia con algunas iteraciones ya corridas (feromonas y depósitos realistas) y los datos de cada núcleo
+static bool Preparar_Banco(Banco *banco, Instancia *instancia, Hormiga *Aleatorio)
+{
+    memset(banco, 0, sizeof(*banco));
+    banco->instancia = instancia;
+    Configuracion_Colonia Configuracion = {.Alpha = 1,
+                                           .Beta = 2,
+                                           .Gamma = 1,
+                                           .Rho = 0.1,
+                                           .Numero_Iteraciones = 0,
+                                           .Numero_Hormigas = 10,
+                                           .Semilla = 1,
+                                           .Numero_Hilos = 1,
+                                           .Hormigas_Busqueda_Local = 1,
+                                           .Estrategia = ESTRATEGIA_AS};
+    banco->colonia = Crear_Colonia(instancia, &Configuracion);
+    if (banco->colonia == NULL)
+    {
+        return false;
+    }
+    for (int x = 0; x < 10; x++)
+    {
+        Construir_Hormigas(banco->colonia);
+        Registrar_Hormigas(banco->colonia);
+        Actualizar_Feromonas(banco->colonia);
+        Reiniciar_Memoria_Hilos(banco->colonia);
+        Actualizar_Atractivo(banco->colonia);
+    }
+    Construir_Hormigas(banco->colonia); // Deja los depósitos de una iteración para Actualizar_Feromonas
+    Registrar_Hormigas(banco->colonia);
+
+    int n = instancia->Numero_Clientes;
+    int V = instancia->Numero_Vehiculos;
+    Hormiga *hormiga = &banco->hormiga;
+    hormiga->Visitado = malloc(n * sizeof(bool));
+    hormiga->Vehiculos = calloc(V, sizeof(Vehicle));
+    hormiga->Orden = malloc(n * sizeof(int));
+    hormiga->Vehiculo_Orden = malloc(n * sizeof(int));
+    hormiga->Destinos_Posibles = malloc(n * sizeof(int));
+    hormiga->Acumulados = malloc(n * sizeof(double));
+    hormiga->Nodos = malloc((n + 2 * (size_t)V) * sizeof(int));
+    hormiga->Inicio_Ruta = malloc((V + 1) * sizeof(int));
+    banco->Visitado_Paso = malloc(n * sizeof(bool));
+    banco->Acumulados = malloc(n * sizeof(double));
+    banco->Recorrido = malloc((n + 1) * sizeof(int));
+    banco->Nodos_Construidos = malloc((n + 2 * (size_t)V) * sizeof(int));
+    banco->Inicio_Construido = malloc((V + 1) * sizeof(int));
+    if (hormiga->Visitado == NULL || hormiga->Vehiculos == NULL || hormiga->Orden == NULL || hormiga->Vehiculo_Orden == NULL ||
+        hormiga->Destinos_Posibles == NULL || hormiga->Acumulados == NULL || hormiga->Nodos == NULL ||
+        hormiga->Inicio_Ruta == NULL || banco->Visitado_Paso == NULL || banco->Acumulados == NULL || banco->Recorrido == NULL ||
+        banco->Nodos_Construidos == NULL || banco->Inicio_Construido == NULL)
+    {
+        return false;
+    }
+    Sembrar_Hormiga(hormiga, 1, 0);
+    hormiga->Vehiculos[0].capacity = instancia->Capacidad;
+
+    // La búsqueda local parte de la primera hormiga de la colonia que completó su solución
+    for (int h = 0; h < banco->colonia->Configuracion.Numero_Hormigas && !banco->Hay_Solucion; h++)
+    {
+        const Hormiga *Construida = &banco->colonia->Hormigas[h];
+        if (Construida->Completa)
+        {
+            banco->Hay_Solucion = true;
+            banco->Rutas_Construidas = Construida->Numero_Rutas;
+            banco->Distancia_Construida = Construida->Distancia;
+            memcpy(banco->Nodos_Construidos, Construida->Nodos, Construida->Inicio_Ruta[Construida->Numero_Rutas] * sizeof(int));
+            memcpy(banco->Inicio_Construido, Construida->Inicio_Ruta, (Construida->Numero_Rutas + 1) * sizeof(int));
+        }
+    }
+
+    // La mitad de los clientes ya visitados y cada paso parte de uno de ellos al terminar su servicio
+    banco->Visitado_Paso[0] = true;
+    for (int c = 1; c < n; c++)
+    {
+        banco->Visitado_Paso[c] = Aleatorio_Real(Aleatorio) < 0.5;
+    }
+    for (int e = 0; e < NUMERO_ESTADOS; e++)
+    {
+        int Origen = 1 + Aleatorio_Entero(Aleatorio, n - 1);
+        banco->Estados[e].Origen = Origen;
+        banco->Estados[e].Tiempo_Consumido = instancia->clientes[Origen].Tiempo_Inicio + instancia->clientes[Origen].Tiempo_Servicio;
+        banco->Estados[e].Carga = Aleatorio_Entero(Aleatorio, instancia->Capacidad / 2);
+    }
+    for (int p = 0; p < NUMERO_PARES; p++)
+    {
+        banco->Pares[p][0] = Aleatorio_Entero(Aleatorio, n);
+        banco->Pares[p][1] = Aleatorio_Entero(Aleatorio, n);
+    }
+    double Suma = 0;
+    for (int j = 0; j < n; j++)
+    {
+        Suma += Aleatorio_Real(Aleatorio);
+        banco->Acumulados[j] = Suma;
+    }
+
+    // Recorrido por todos los clientes en orden aleatorio (Fisher-Yates)
+    banco->Recorrido[0] = banco->Recorrido[n] = 0;
+    for (int c = 1; c < n; c++)
+    {
+        banco->Recorrido[c] = c;
+    }
+    for (int c = n - 1; c > 1; c--)
+    {
+        int k = 1 + Aleatorio_Entero(Aleatorio, c);
+        int Temporal = banco->Recorrido[c];
+        banco->Recorrido[c] = banco->Recorrido[k];
+        banco->Recorrido[k] = Temporal;
+    }
+    return true;
+}
+
+static void Liberar_Banco(Banco *banco)
+{
+    Hormiga *hormiga = &banco->hormiga;
+    free(hormiga->Visitado);
+    free(hormiga->Vehiculos);
+    free(hormiga->Orden);
+    free(hormiga->Vehiculo_Orden);
+    free(hormiga->Destinos_Posibles);
+    free(hormiga->Acumulados);
+    free(hormiga->Nodos);
+    free(hormiga->Inicio_Ruta);
+    free(banco->Visitado_Paso);
+    free(banco->Acumulados);
+    free(banco->Recorrido);
+    free(banco->Nodos_Construidos);
+    free(banco->Inicio_Construido);
+    if (banco->colonia != NULL)
+    {
+        Liberar_Colonia(banco->colonia);
+    }
+    Liberar_Instancia(banco->instancia);
+}
+
+int main(int argc, char *argv[])
+{
+    // Uso: ./Colonia_Microbenchmark [resultados.csv]
+    FILE *CSV = NULL;
+    if (argc > 1)
+    {
+        CSV = fopen(argv[1], "w");
+        if (CSV == NULL)
+        {
+            fprintf(stderr, "No se pudo crear %s\n", argv[1]);
+            return 1;
+        }
+        fprintf(CSV, "nucleo,entrada,clientes,mediana_ns,minimo_ns,mad_ns,operaciones_repeticion\n");
+    }
+
+    Instancia *Base_Solomon = Cargar_Instancia(INSTANCIA_SOLOMON);
+    if (Base_Solomon == NULL)
+    {
+        return 1;
+    }
+
+    static const struct
+    {
+        const char *Nombre;
+        Nucleo nucleo;
+    } Nucleos[] = {
+        {"Calculo_Probabilidad", Nucleo_Calculo_Probabilidad},
+        {"Filtrar_Todos (n)", Nucleo_Filtrar_Todos},
+        {"Calcular_Numerador", Nucleo_Calcular_Numerador},
+        {"Probabilidad (n destinos)", Nucleo_Probabilidad},
+        {"Seleccion_Parte (k)", Nucleo_Seleccion_Candidatos},
+        {"Seleccion_Parte (n)", Nucleo_Seleccion_Todos},
+        {"Construir_Solucion", Nucleo_Construir_Solucion},
+        {"Recorrer_Ruta_Distancia", Nucleo_Recorrer_Ruta_Distancia},
+        {"Actualizar_Feromonas", Nucleo_Actualizar_Feromonas},
+        {"Actualizar_Atractivo", Nucleo_Actualizar_Atractivo},
+        {"Potencias_Atractivo (n)", Nucleo_Potencias_Atractivo},
+        {"Potencias con pow (n)", Nucleo_Potencias_Escalar},
+        {"Mejorar_Hormiga", Nucleo_Mejorar_Hormiga},
+        {"inicializar_matrices", Nucleo_Inicializar_Matrices},
+    };
+    const int Tamanos[] = {100, 400, 1000};
+
+    Hormiga Aleatorio;
+    Sembrar_Hormiga(&Aleatorio, 12345, 0);
+    double Diferencia = 0, Diferencia_Feromonas = 0;
+    int Normalizaciones = 0, Sin_Medir = 0;
+    printf("%-28s %-9s %5s %14s %14s %8s\n", "Nucleo", "Entrada", "n", "Mediana ns/op", "Minimo ns/op", "MAD");
+    for (int t = 0; t < (int)(sizeof(Tamanos) / sizeof(Tamanos[0])); t++)
+    {
+        for (int Tipo = 0; Tipo < 2; Tipo++)
+        {
+            Instancia *instancia = Tipo == 0 ? Instancia_Sintetica(Tamanos[t], &Aleatorio) : Instancia_Solomon(Tamanos[t], Base_Solomon, &Aleatorio);
+            Banco banco;
+            if (instancia == NULL || !Preparar_Banco(&banco, instancia, &Aleatorio))
+            {
+                fprintf(stderr, "No se pudo preparar la instancia de %d clientes\n", Tamanos[t]);
+                return 1;
+            }
+            for (int k = 0; k < (int)(sizeof(Nucleos) / sizeof(Nucleos[0])); k++)
+            {
+                const char *Entrada = Tipo == 0 ? "sintetica" : "solomon";
+                // Sin ninguna hormiga completa no hay solución que mejorar ni depósitos que sumar, el tiempo no diría nada
+                if ((Nucleos[k].nucleo == Nucleo_Mejorar_Hormiga || Nucleos[k].nucleo == Nucleo_Actualizar_Feromonas) &&
+                    !banco.Hay_Solucion)
+                {
+                    printf("%-28s %-9s %5d no medido: ninguna hormiga factible\n", Nucleos[k].Nombre, Entrada, Tamanos[t]);
+                    if (CSV != NULL)
+                    {
+                        fprintf(CSV, "%s,%s,%d,,,,0\n", Nucleos[k].Nombre, Entrada, Tamanos[t]);
+                    }
+                    Sin_Medir++;
+                    continue;
+                }
+                Medir(Nucleos[k].Nombre, Entrada, &banco, Nucleos[k].nucleo, CSV);
+            }
+            Diferencia = fmax(Diferencia, Diferencia_Potencias(&banco));
+            Diferencia_Feromonas = fmax(Diferencia_Feromonas, Diferencia_Evaporacion(&banco, &Normalizaciones));
+            Liberar_Banco(&banco);
+        }
+    }
+
+    Liberar_Instancia(Base_Solomon);
+    if (CSV != NULL && fclose(CSV) != 0)
+    {
+        return 1;
+    }
+
+    // Los numeradores vectoriales deben coincidir con los de pow y la evaporación en la escala con la de toda la matriz, dentro de
+    // la tolerancia
+    printf("Potencias_Atractivo contra pow: diferencia relativa maxima %.3g (tolerancia %g)\n", Diferencia, TOLERANCIA_POTENCIAS);
+    printf("Evaporacion en la escala contra toda la matriz, %d iteraciones y %d normalizaciones: diferencia relativa maxima %.3g "
+           "(tolerancia %g)\n",
+           ITERACIONES_EVAPORACION, Normalizaciones, Diferencia_Feromonas, TOLERANCIA_EVAPORACION);
+    if (Sin_Medir > 0)
+    {
+        printf("%d mediciones sin hacer: alguna instancia no tuvo ninguna hormiga factible\n", Sin_Medir);
+    }
+    return Diferencia <= TOLERANCIA_POTENCIAS && Diferencia_Feromonas <= TOLERANCIA_EVAPORACION && Normalizaciones > 0 &&
+                   Sin_Medir == 0
+               ? 0
+               : 1;
+}
@@ -0,0 +1,49 @@
+"""
+Autor: Williams Chan Pescador
+Descripción: Este script genera una instancia aleatoria en el mismo formato CSV que Converter_TXT_CSV.py,
+con el número de clientes que se necesite, para probar la colonia con instancias más grandes que las de Solomon.
+Las ventanas de tiempo abren antes del tiempo de llegada directa desde el deposito, ya que la colonia no espera a que abra la
+ventana; así cualquier llegada cumple el inicio y la instancia es factible si el vencimiento es holgado.
+"""
+
+import csv
+import math
+import random
+import sys
+import os
+
+
+# Función para generar una instancia con num_clientes clientes más el deposito
+def generar_instancia(output_file, name_instance, num_clientes, semilla):
+    random.seed(semilla)
+    lado = 100 * math.sqrt(num_clientes / 100)  # El área crece con el número de clientes
+    horizonte = int(4 * lado + 1000)
+    capacidad = 200
+    num_vehiculos = max(25, num_clientes // 4)
+
+    with open(output_file, 'w', newline='') as outfile:
+        writer = csv.writer(outfile)
+        writer.writerow([name_instance])
+        writer.writerow([num_vehiculos, capacidad])
+        deposito = (lado / 2, lado / 2)
+        writer.writerow([0, round(deposito[0]), round(deposito[1]), 0, 0, horizonte, 0])
+        for cliente in range(1, num_clientes + 1):
+            x = random.uniform(0, lado)
+            y = random.uniform(0, lado)
+            llegada = math.dist(deposito, (x, y))
+            inicio = int(random.uniform(0, llegada))
+            fin = random.randint(int(llegada) + 60, horizonte - int(llegada) - 10)
+            writer.writerow([cliente, round(x), round(y), random.randint(1, 40), inicio, fin, 10])
+
+
+if __name__ == "__main__":
+    # Uso: python Generar_Instancia.py <num_clientes> [semilla]
+    num_clientes = int(sys.argv[1]) if len(sys.argv) > 1 else 1000
+    semilla = int(sys.argv[2]) if len(sys.argv) > 2 else 1
+
+    output_directory = "Instancias/Csv/"
+    name_instance = "G" + str(num_clientes)
+
+    csv_file = os.path.join(output_directory, name_instance + ".csv")
+    generar_instancia(csv_file, name_instance, num_clientes, semilla)
+    print(f"Se ha generado {csv_file} con {num_clientes} clientes")
@@ -0,0 +1,73 @@
+"""
+Autor: Williams Chan Pescador
+Descripción: Este script convierte una instantánea binaria de una matriz de la colonia (Matriz_Feromonas.bin o
+Matriz_Visibilidad.bin) al formato CSV de antes, para revisarla a mano. El formato del encabezado está descrito en
+Colonia_Hormigas.h; el archivo se mapea a memoria en lugar de leerlo completo.
+"""
+
+import mmap
+import struct
+import sys
+import os
+
+TAM_ENCABEZADO = 128
+TIPOS = {1: "Feromonas", 2: "Visibilidad"}
+
+
+# Función para leer el encabezado de la instantánea
+def leer_encabezado(datos):
+    if datos[0:8] != b"ACOMATRZ":
+        raise ValueError("El archivo no es una instantánea de matriz de la colonia")
+    version, tipo, renglones, columnas, iteracion, semilla = struct.unpack_from("<IIIIiI", datos, 8)
+    if version != 1:
+        raise ValueError(f"Versión de formato {version} no soportada")
+    nombre = datos[32:80].split(b"\0", 1)[0].decode("ascii", errors="replace")
+    alpha, beta, gamma, rho = struct.unpack_from("<dddd", datos, 80)
+    num_iteraciones, num_hormigas = struct.unpack_from("<ii", datos, 112)
+    return {
+        "tipo": TIPOS.get(tipo, str(tipo)),
+        "renglones": renglones,
+        "columnas": columnas,
+        "iteracion": iteracion,
+        "semilla": semilla,
+        "instancia": nombre,
+        "alpha": alpha,
+        "beta": beta,
+        "gamma": gamma,
+        "rho": rho,
+        "num_iteraciones": num_iteraciones,
+        "num_hormigas": num_hormigas,
+    }
+
+
+# Función para convertir la instantánea binaria a CSV
+def bin_to_csv(input_file, output_file):
+    with open(input_file, "rb") as infile, open(output_file, "w") as outfile:
+        with mmap.mmap(infile.fileno(), 0, access=mmap.ACCESS_READ) as datos:
+            encabezado = leer_encabezado(datos)
+            renglones = encabezado["renglones"]
+            columnas = encabezado["columnas"]
+            if len(datos) < TAM_ENCABEZADO + 8 * renglones * columnas:
+                raise ValueError("El archivo está incompleto")
+
+            formato_renglon = "<" + "d" * columnas
+            for i in range(renglones):
+                renglon = struct.unpack_from(formato_renglon, datos, TAM_ENCABEZADO + 8 * columnas * i)
+                # Mismo formato que el "%lf" de la colonia
+                outfile.write(",".join(f"{valor:f}" for valor in renglon) + "\n")
+    return encabezado
+
+
+if __name__ == "__main__":
+    # Uso: python Convertir_Matriz_CSV.py <matriz.bin> [salida.csv]
+    if len(sys.argv) < 2:
+        print("Uso: python Convertir_Matriz_CSV.py <matriz.bin> [salida.csv]")
+        sys.exit(1)
+
+    bin_file = sys.argv[1]
+    csv_file = sys.argv[2] if len(sys.argv) > 2 else os.path.splitext(bin_file)[0] + ".csv"
+    encabezado = bin_to_csv(bin_file, csv_file)
+    print(f"Matriz de {encabezado['tipo']} de {encabezado['instancia']} ({encabezado['renglones']}x{encabezado['columnas']}), "
+          f"iteración {encabezado['iteracion']}, alpha={encabezado['alpha']} beta={encabezado['beta']} "
+          f"gamma={encabezado['gamma']} rho={encabezado['rho']}")
+    print(f"Se ha convertido {bin_file} a {csv_file}")